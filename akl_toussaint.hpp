@@ -0,0 +1,270 @@
+#ifndef akl_toussaint_hpp
+#define akl_toussaint_hpp
+
+#include <vector>
+#include <string>
+#include <sstream>
+#include <functional>
+#include <cmath>
+#include <cstdint>
+
+#include "convex_hull_base.hpp"
+#include "graham_scan.hpp"
+#include "monotone_chain.hpp"
+#include "point.hpp"
+#include "point_cloud.hpp"
+#include "orientation_kernels.hpp"
+#include "orientation.hpp"
+
+namespace csce {
+	/**
+	 * Runs the Akl-Toussaint heuristic before the convex hull algorithm U. The 8 extreme
+	 * points (min/max of x, y, x+y and x-y) form an octagon whose vertices are all on the
+	 * convex hull, so every point strictly inside of the octagon can be thrown away before
+	 * U ever sees it.
+	 */
+	template<typename T, typename U = csce::graham_scan<T>>
+	class akl_toussaint : public csce::convex_hull_base<T> {
+	public:
+		using csce::convex_hull_base<T>::compute_hull;
+		
+		akl_toussaint(int _nthreads) : csce::convex_hull_base<T>(_nthreads) {}
+		~akl_toussaint() {}
+
+
+		std::string name() const {
+			return std::string("Akl-Toussaint <").append(U(0).name()).append(">");
+		}
+
+
+		virtual std::vector<csce::point<T>> compute_hull(std::vector<csce::point<T>>& points) {
+			return this->compute_hull(csce::point_span<T>(points));
+		}
+
+
+		/**
+		 * The pre-filter only reads the points, so the input is never changed: U reorders its own copy of the survivors.
+		 */
+		virtual std::vector<csce::point<T>> compute_hull(const csce::point_span<T>& points) {
+			this->input_count = points.size();
+			std::vector<csce::point<T>> survivors = this->filter(points);
+			this->survivor_count = survivors.size();
+			U algorithm(this->nthreads);
+			algorithm.set_executor(this->pool);
+			return algorithm.compute_hull(survivors);
+		}
+
+
+		/**
+		 * The pre-filter reads the x and y arrays directly, so only the survivors are copied into a vector for U.
+		 */
+		virtual std::vector<csce::point<T>> compute_hull(const csce::point_cloud_view<T>& points) {
+			this->input_count = points.size();
+			std::vector<csce::point<T>> survivors = this->filter(points);
+			this->survivor_count = survivors.size();
+			U algorithm(this->nthreads);
+			algorithm.set_executor(this->pool);
+			return algorithm.compute_hull(survivors);
+		}
+
+
+		std::string summary() const {
+			std::stringstream output;
+			output << "pre-filter kept " << this->survivor_count << " / " << this->input_count << " points";
+			return output.str();
+		}
+
+
+		/**
+		 * The number of points that survived the pre-filter during the last call to compute_hull.
+		 */
+		std::size_t survivors() const {
+			return this->survivor_count;
+		}
+
+
+		/**
+		 * Returns the points that are not strictly inside of the extreme point octagon.
+		 */
+		std::vector<csce::point<T>> filter(const csce::point_span<T>& points) const {
+			std::size_t segment_count = this->segment_count(points.size());
+			std::vector<csce::point<T>> octagon = this->octagon(points, segment_count);
+			if(octagon.size() < 3){
+				return std::vector<csce::point<T>>(points.begin(), points.end()); //the octagon has no interior
+			}
+
+			std::vector<std::vector<csce::point<T>>> kept(segment_count);
+			this->run_segments(points.size(), segment_count, [&](std::size_t x, std::size_t start, std::size_t stop) {
+				this->filter_thread(points, start, stop, octagon, kept[x]);
+			});
+			return this->concatenate(kept);
+		}
+
+
+		/**
+		 * The same filter for points in separate x and y arrays. Every segment is tested against one
+		 * octagon edge at a time with orientation_kernels, and only the points that are not left of
+		 * some edge are copied.
+		 */
+		std::vector<csce::point<T>> filter(const csce::point_cloud_view<T>& points) const {
+			std::size_t segment_count = this->segment_count(points.size());
+			std::vector<csce::point<T>> octagon = this->octagon(points, segment_count);
+			if(octagon.size() < 3){
+				return points.to_vector();
+			}
+
+			std::vector<std::vector<csce::point<T>>> kept(segment_count);
+			this->run_segments(points.size(), segment_count, [&](std::size_t x, std::size_t start, std::size_t stop) {
+				csce::point_cloud_view<T> segment = points.view(start, stop);
+				std::vector<std::uint64_t> outside((segment.size() + 63) / 64);
+				for(std::size_t y=0; y<octagon.size(); y++){
+					csce::orientation_kernels::mark_not(segment.x(), segment.y(), segment.size(), octagon[y], octagon[(y + 1) % octagon.size()], 1, outside.data());
+				}
+				for(std::size_t y=0; y<segment.size(); y++){
+					if((outside[y / 64] >> (y % 64)) & 1){
+						kept[x].push_back(segment[y]);
+					}
+				}
+			});
+			return this->concatenate(kept);
+		}
+
+
+	private:
+		std::size_t input_count = 0;
+		std::size_t survivor_count = 0;
+
+
+		std::size_t segment_count(std::size_t size) const {
+			std::size_t segment_count = std::max(1, this->nthreads);
+			if(size < 1600 * segment_count){
+				segment_count = 1; //not worth splitting into tasks
+			}
+			return segment_count;
+		}
+
+
+		/**
+		 * Calls work(segment, start, stop) for every segment of [0, size), each as its own task.
+		 */
+		void run_segments(std::size_t size, std::size_t segment_count, const std::function<void(std::size_t, std::size_t, std::size_t)>& work) const {
+			if(segment_count == 1){
+				work(0, 0, size);
+				return;
+			}
+
+			std::size_t nelements = (size + segment_count - 1) / segment_count;
+			this->executor().fork_join(segment_count, [&](std::size_t x) {
+				work(x, std::min(x * nelements, size), std::min((x + 1) * nelements, size));
+			});
+		}
+
+
+		/**
+		 * The extreme point octagon in counterclockwise order without repeated vertices, or fewer than
+		 * 3 points if it has no interior. Points is a point_span or a point_cloud_view.
+		 */
+		template<typename Points>
+		std::vector<csce::point<T>> octagon(const Points& points, std::size_t segment_count) const {
+			std::vector<csce::point<T>> octagon;
+			if(points.size() <= 8){
+				return octagon;
+			}
+
+			//find the extreme points of each segment, then reduce them
+			std::vector<std::vector<std::size_t>> extremes(segment_count, std::vector<std::size_t>(8, 0));
+			this->run_segments(points.size(), segment_count, [&](std::size_t x, std::size_t start, std::size_t stop) {
+				this->extremes_thread(points, start, stop, extremes[x]);
+			});
+
+			std::vector<std::size_t> combined = extremes[0];
+			for(std::size_t x=1; x<segment_count; x++){
+				for(std::size_t y=0; y<8; y++){
+					if(this->more_extreme(points[extremes[x][y]], points[combined[y]], y)){
+						combined[y] = extremes[x][y];
+					}
+				}
+			}
+
+			//the extremes are in counterclockwise order around the hull, so drop repeated vertices
+			for(std::size_t y=0; y<8; y++){
+				csce::point<T> p = points[combined[y]];
+				if(octagon.empty() || (octagon.back() != p && octagon.front() != p)){
+					octagon.push_back(p);
+				}
+			}
+			return octagon;
+		}
+
+
+		std::vector<csce::point<T>> concatenate(const std::vector<std::vector<csce::point<T>>>& kept) const {
+			std::size_t total = 0;
+			for(auto& segment : kept){
+				total += segment.size();
+			}
+
+			std::vector<csce::point<T>> survivors;
+			survivors.reserve(total);
+			for(auto& segment : kept){
+				survivors.insert(survivors.end(), segment.begin(), segment.end());
+			}
+			return survivors;
+		}
+
+
+		/**
+		 * The directions are ordered counterclockwise starting at -y:
+		 * min y, max x-y, max x, max x+y, max y, min x-y, min x, min x+y.
+		 * The sums and differences are computed in the wide type (see orientation::wide), so they do
+		 * not overflow for integer coordinates.
+		 */
+		bool more_extreme(const csce::point<T>& a, const csce::point<T>& b, std::size_t direction) const {
+			typedef typename csce::orientation::wide<T>::type W;
+			switch(direction){
+				case 0: return a.y < b.y;
+				case 1: return static_cast<W>(a.x) - a.y > static_cast<W>(b.x) - b.y;
+				case 2: return a.x > b.x;
+				case 3: return static_cast<W>(a.x) + a.y > static_cast<W>(b.x) + b.y;
+				case 4: return a.y > b.y;
+				case 5: return static_cast<W>(a.x) - a.y < static_cast<W>(b.x) - b.y;
+				case 6: return a.x < b.x;
+				default: return static_cast<W>(a.x) + a.y < static_cast<W>(b.x) + b.y;
+			}
+		}
+
+
+		template<typename Points>
+		void extremes_thread(const Points& points, std::size_t start, std::size_t stop, std::vector<std::size_t>& output) const {
+			if(start >= stop){
+				return; //output keeps pointing at index 0, which is always a valid candidate
+			}
+
+			std::fill(output.begin(), output.end(), start);
+			for(std::size_t x=start + 1; x<stop; x++){
+				for(std::size_t y=0; y<8; y++){
+					if(this->more_extreme(points[x], points[output[y]], y)){
+						output[y] = x;
+					}
+				}
+			}
+		}
+
+
+		void filter_thread(const csce::point_span<T>& points, std::size_t start, std::size_t stop, const std::vector<csce::point<T>>& octagon, std::vector<csce::point<T>>& output) const {
+			for(std::size_t x=start; x<stop; x++){
+				const csce::point<T>& p = points[x];
+				bool inside = true;
+				for(std::size_t y=0; y<octagon.size() && inside; y++){
+					const csce::point<T>& a = octagon[y];
+					const csce::point<T>& b = octagon[(y + 1) % octagon.size()];
+					inside = csce::monotone_chain<T>::cross(a, b, p) > 0;
+				}
+				if(!inside){
+					output.push_back(p);
+				}
+			}
+		}
+	};
+}
+
+#endif /* akl_toussaint_hpp */
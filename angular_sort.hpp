@@ -0,0 +1,130 @@
+#ifndef angular_sort_hpp
+#define angular_sort_hpp
+
+#include <vector>
+#include <cstdint>
+#include <cstring>
+#include <cmath>
+#include <limits>
+#include <iterator>
+#include <algorithm>
+
+#include "point.hpp"
+#include "orientation.hpp"
+#include "radix_sort.hpp"
+#include "executor.hpp"
+#include "scratch_arena.hpp"
+
+namespace csce {
+	/**
+	 * Orders points by angle around a pivot, and points at the same angle by their distance from it.
+	 * The pivot has to be the lowest point (the leftmost of the lowest if there is a tie), so every
+	 * point is in the half plane above it, where the cross product compares angles. Copies of the
+	 * pivot come first. For integer and double coordinates this is a strict weak ordering, which
+	 * std::sort needs: two points are only equivalent if they are the same point.
+	 */
+	template<typename T>
+	struct angle_less {
+		csce::point<T> pivot;
+
+		angle_less(const csce::point<T>& pivot_point) : pivot(pivot_point) {}
+
+		bool operator()(const csce::point<T>& a, const csce::point<T>& b) const {
+			int turn = csce::orientation::turn(this->pivot, a, b);
+			if(turn != 0){
+				return turn > 0;
+			}
+			//a and b are on the same ray from the pivot, which points up or to the right
+			return a.y < b.y || (a.y == b.y && a.x < b.x);
+		}
+	};
+
+
+	/**
+	 * Sorts points in the order of angle_less without comparing them. Every point gets a 64-bit key:
+	 * the high 32 bits are its pseudo-angle around the pivot, 1 - dx / (|dx| + dy), which grows with
+	 * the angle from 0 to 2, and the low 32 bits are its squared distance from the pivot as a float
+	 * (whose bits are ordered like the value). The keys are radix sorted.
+	 *
+	 * The pseudo-angle is rounded, so points whose angles are a few units of 2^-31 apart can come out
+	 * in the wrong order. Those are always next to each other after the sort, so every run of keys
+	 * that are that close is sorted again with angle_less, which makes the order exact. Such runs are
+	 * short unless many points are collinear with the pivot.
+	 *
+	 * The keys and the sorted copy are taken from the arena, if there is one.
+	 */
+	template<typename T>
+	class angular_sort {
+	public:
+		angular_sort(const csce::point<T>& pivot_point, csce::executor& _pool, csce::scratch_arena* _arena = nullptr) : p(pivot_point), pool(_pool), arena(_arena) {}
+
+		void sort_array(typename std::vector<csce::point<T>>::iterator begin, typename std::vector<csce::point<T>>::iterator end) {
+			std::size_t n = static_cast<std::size_t>(std::distance(begin, end));
+			if(n < 2){
+				return;
+			}
+			if(n > std::numeric_limits<std::uint32_t>::max()){
+				throw "angular_sort: too many points to sort";
+			}
+
+			csce::scratch_vector<std::uint64_t> keys(n, 0, csce::arena_allocator<std::uint64_t>(this->arena));
+			csce::scratch_vector<std::uint32_t> order(n, 0, csce::arena_allocator<std::uint32_t>(this->arena));
+			for(std::size_t x=0; x<n; x++){
+				keys[x] = this->key(begin[x]);
+				order[x] = static_cast<std::uint32_t>(x);
+			}
+			csce::radix_sort::sort(keys, order, this->pool);
+
+			csce::scratch_vector<csce::point<T>> sorted(csce::arena_allocator<csce::point<T>>(this->arena));
+			sorted.reserve(n);
+			for(std::size_t x=0; x<n; x++){
+				sorted.push_back(begin[order[x]]);
+			}
+
+			angle_less<T> less(this->p);
+			std::size_t start = 0;
+			for(std::size_t x=1; x<=n; x++){
+				if(x == n || (keys[x] >> 32) - (keys[x - 1] >> 32) > angle_tolerance){
+					if(x - start > 1){
+						std::sort(sorted.begin() + start, sorted.begin() + x, less);
+					}
+					start = x;
+				}
+			}
+
+			std::copy(sorted.begin(), sorted.end(), begin);
+		}
+
+
+		/**
+		 * The sort key of a point above the pivot.
+		 */
+		std::uint64_t key(const csce::point<T>& q) const {
+			double dx = static_cast<double>(q.x - this->p.x);
+			double dy = static_cast<double>(q.y - this->p.y);
+			double length = std::abs(dx) + dy;
+			if(length <= 0){
+				return 0; //a copy of the pivot
+			}
+
+			double angle = std::ldexp(1.0 - dx / length, 31);
+			std::uint64_t high = static_cast<std::uint64_t>(std::min(angle, std::ldexp(1.0, 32) - 1));
+
+			float distance = static_cast<float>(dx * dx + dy * dy);
+			std::uint32_t low;
+			std::memcpy(&low, &distance, sizeof(low));
+			return (high << 32) | low;
+		}
+
+
+	private:
+		//the pseudo-angle is off by far less than 2^-31, but it can be truncated either way
+		static const std::uint64_t angle_tolerance = 2;
+
+		csce::point<T> p;
+		csce::executor& pool;
+		csce::scratch_arena* arena;
+	};
+}
+
+#endif /* angular_sort_hpp */
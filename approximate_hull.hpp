@@ -0,0 +1,269 @@
+#ifndef approximate_hull_hpp
+#define approximate_hull_hpp
+
+#include <vector>
+#include <string>
+#include <sstream>
+#include <cmath>
+#include <limits>
+#include <algorithm>
+
+#include "convex_hull_base.hpp"
+#include "point.hpp"
+#include "monotone_chain.hpp"
+
+namespace csce {
+	/**
+	 * A coreset made of the extreme points of a set in k evenly spaced directions. Two coresets
+	 * with the same number of directions merge by keeping the more extreme point per direction,
+	 * so shards of the input can be summarized independently and combined afterwards.
+	 *
+	 * The hull of the extreme points is inside the true hull, and the true hull is inside the
+	 * polygon formed by the supporting lines in the k directions. The distance between the two
+	 * polygons is computed from the coreset alone, which gives a certified bound on how far any
+	 * input point can be from the approximate hull.
+	 */
+	template<typename T>
+	class directional_coreset {
+	public:
+		directional_coreset(std::size_t _directions) : directions(std::max<std::size_t>(4, _directions + _directions % 2)), extremes(directions), support(directions, -std::numeric_limits<long double>::infinity()) {
+			const long double pi = std::acos(-1.0L);
+			for(std::size_t x=0; x<this->directions; x++){
+				long double angle = 2 * pi * x / this->directions;
+				this->cosines.push_back(std::cos(angle));
+				this->sines.push_back(std::sin(angle));
+			}
+		}
+
+
+		void add(const csce::point<T>& p) {
+			for(std::size_t x=0; x<this->directions; x++){
+				long double value = this->cosines[x] * p.x + this->sines[x] * p.y;
+				if(value > this->support[x]){
+					this->support[x] = value;
+					this->extremes[x] = p;
+				}
+			}
+		}
+
+
+		template<typename Iterator>
+		void add(Iterator begin, Iterator end) {
+			for(Iterator it = begin; it != end; it++){
+				this->add(*it);
+			}
+		}
+
+
+		/**
+		 * Adds the other coreset's extreme points to this one. Both must use the same number of directions.
+		 */
+		void merge(const csce::directional_coreset<T>& other) {
+			if(other.directions != this->directions){
+				throw "Coresets with a different number of directions cannot be merged!";
+			}
+			for(std::size_t x=0; x<this->directions; x++){
+				if(other.support[x] > this->support[x]){
+					this->support[x] = other.support[x];
+					this->extremes[x] = other.extremes[x];
+				}
+			}
+		}
+
+
+		bool empty() const {
+			return std::isinf(this->support[0]);
+		}
+
+
+		std::size_t size() const {
+			return this->directions;
+		}
+
+
+		/**
+		 * The distinct extreme points.
+		 */
+		std::vector<csce::point<T>> points() const {
+			std::vector<csce::point<T>> output;
+			if(this->empty()){
+				return output;
+			}
+			output = this->extremes;
+			std::sort(output.begin(), output.end(), csce::monotone_chain<T>::lexicographic_less);
+			output.erase(std::unique(output.begin(), output.end()), output.end());
+			return output;
+		}
+
+
+		/**
+		 * The hull of the extreme points as a counterclockwise polygon starting at the left-most point.
+		 */
+		std::vector<csce::point<T>> hull() const {
+			std::vector<csce::point<T>> points = this->points();
+			if(points.empty()){
+				return points;
+			}
+			std::vector<csce::point<T>> lower = csce::monotone_chain<T>::lower_chain(points.begin(), points.end());
+			std::vector<csce::point<T>> upper = csce::monotone_chain<T>::upper_chain(points.begin(), points.end());
+			return csce::monotone_chain<T>::join_chains(lower, upper);
+		}
+
+
+		/**
+		 * An upper bound on the distance from any added point to hull(). Between the extreme points
+		 * of two neighbouring directions the true hull is inside the triangle they form with the
+		 * corner of the two supporting lines, and that corner is the farthest point of the triangle.
+		 */
+		long double error_bound() const {
+			long double bound = 0;
+			if(this->empty()){
+				return bound;
+			}
+			long double determinant = this->cosines[0] * this->sines[1] - this->sines[0] * this->cosines[1];
+			for(std::size_t x=0; x<this->directions; x++){
+				std::size_t y = (x + 1) % this->directions;
+				if(this->extremes[x] == this->extremes[y]){
+					continue; //both supporting lines go through the same point
+				}
+				long double corner_x = (this->support[x] * this->sines[y] - this->support[y] * this->sines[x]) / determinant;
+				long double corner_y = (this->cosines[x] * this->support[y] - this->cosines[y] * this->support[x]) / determinant;
+				bound = std::max(bound, this->segment_distance(corner_x, corner_y, this->extremes[x], this->extremes[y]));
+			}
+			return bound;
+		}
+
+
+		/**
+		 * A lower bound on the diameter of the added points: their widest extent over the directions.
+		 */
+		long double diameter() const {
+			long double width = 0;
+			if(this->empty()){
+				return width;
+			}
+			for(std::size_t x=0; x<this->directions / 2; x++){
+				width = std::max(width, this->support[x] + this->support[x + this->directions / 2]);
+			}
+			return width;
+		}
+
+
+	private:
+		std::size_t directions;
+		std::vector<csce::point<T>> extremes;
+		std::vector<long double> support;
+		std::vector<long double> cosines;
+		std::vector<long double> sines;
+
+
+		static long double segment_distance(long double px, long double py, const csce::point<T>& a, const csce::point<T>& b) {
+			long double dx = static_cast<long double>(b.x) - a.x;
+			long double dy = static_cast<long double>(b.y) - a.y;
+			long double t = ((px - a.x) * dx + (py - a.y) * dy) / (dx * dx + dy * dy);
+			t = std::max(0.0L, std::min(1.0L, t));
+			long double ex = a.x + t * dx - px;
+			long double ey = a.y + t * dy - py;
+			return std::sqrt(ex * ex + ey * ey);
+		}
+	};
+
+
+	/**
+	 * An approximate convex hull whose vertices are all input points and that is within epsilon
+	 * times the diameter of every input point. It starts with a coreset of about pi / sqrt(epsilon)
+	 * directions, which is enough for hulls without long nearly flat stretches, and doubles the
+	 * directions until the coreset's certified error bound is small enough. After about
+	 * pi / (2 * epsilon) directions the bound always holds, so that is where the doubling stops.
+	 *
+	 * This is not in convex_hull_implementations::list, since its hull does not have to contain
+	 * every point and would fail validation.
+	 */
+	template<typename T>
+	class approximate_hull : public csce::convex_hull_base<T> {
+	public:
+		using csce::convex_hull_base<T>::compute_hull;
+		
+		approximate_hull(int _nthreads, long double _epsilon = 0.01) : csce::convex_hull_base<T>(_nthreads), epsilon(_epsilon) {}
+
+
+		std::string name() const {
+			std::stringstream output;
+			output << "Approximate Hull (epsilon = " << this->epsilon << ")";
+			return output.str();
+		}
+
+
+		virtual std::vector<csce::point<T>> compute_hull(std::vector<csce::point<T>>& points) {
+			return this->compute_hull(csce::point_span<T>(points));
+		}
+
+
+		/**
+		 * The coresets only read the points, so they are summarized straight from the span.
+		 */
+		virtual std::vector<csce::point<T>> compute_hull(const csce::point_span<T>& points) {
+			const long double pi = std::acos(-1.0L);
+			std::size_t directions = static_cast<std::size_t>(std::ceil(pi / std::sqrt(this->epsilon)));
+			std::size_t max_directions = static_cast<std::size_t>(std::ceil(pi / (2 * this->epsilon))) + 1;
+
+			while(true){
+				csce::directional_coreset<T> coreset = this->coreset(points, directions);
+				this->error = coreset.error_bound();
+				this->allowed_error = this->epsilon * coreset.diameter();
+				this->directions_used = coreset.size();
+				if(this->error <= this->allowed_error || directions >= max_directions){
+					return coreset.hull();
+				}
+				directions = std::min(2 * directions, max_directions);
+			}
+		}
+
+
+		std::string summary() const {
+			std::stringstream output;
+			output << this->directions_used << " directions, every point within " << this->error << " of the hull (epsilon * diameter = " << this->allowed_error << ")";
+			return output.str();
+		}
+
+
+		/**
+		 * The certified bound on the distance from any point to the hull from the last call to compute_hull.
+		 */
+		long double error_bound() const {
+			return this->error;
+		}
+
+
+		/**
+		 * Summarizes the points with one coreset per chunk of the points, merged at the end.
+		 */
+		csce::directional_coreset<T> coreset(const csce::point_span<T>& points, std::size_t directions) const {
+			const std::size_t minimum_chunk = 1 << 14;
+			std::vector<csce::directional_coreset<T>> coresets(this->executor().chunk_count(points.size(), minimum_chunk), csce::directional_coreset<T>(directions));
+
+			this->executor().parallel_for(points.size(), minimum_chunk, [&](std::size_t chunk, std::size_t begin, std::size_t end) {
+				for(std::size_t x=begin; x<end; x++){
+					coresets[chunk].add(points[x]);
+				}
+			});
+
+			for(std::size_t x=1; x<coresets.size(); x++){
+				coresets[0].merge(coresets[x]);
+			}
+			return coresets[0];
+		}
+
+
+		~approximate_hull() {}
+
+
+	private:
+		long double epsilon;
+		long double error = 0;
+		long double allowed_error = 0;
+		std::size_t directions_used = 0;
+	};
+}
+
+#endif /* approximate_hull_hpp */
@@ -0,0 +1,215 @@
+#ifndef batch_hulls_hpp
+#define batch_hulls_hpp
+
+#include <vector>
+#include <memory>
+#include <atomic>
+#include <algorithm>
+
+#include "point.hpp"
+#include "monotone_chain.hpp"
+#include "executor.hpp"
+
+namespace csce {
+	/**
+	 * Many point sets packed into one buffer (compressed sparse row layout). Set i is
+	 * points[offsets[i]] up to points[offsets[i+1]], so offsets has one more entry than there are sets.
+	 */
+	template<typename T>
+	struct point_batch {
+		std::vector<csce::point<T>> points;
+		std::vector<std::size_t> offsets = std::vector<std::size_t>(1, 0);
+
+		std::size_t size() const {
+			return this->offsets.size() - 1;
+		}
+
+		template<typename Iterator>
+		void push_back(Iterator begin, Iterator end) {
+			this->points.insert(this->points.end(), begin, end);
+			this->offsets.push_back(this->points.size());
+		}
+
+		typename std::vector<csce::point<T>>::const_iterator begin(std::size_t set) const {
+			return this->points.begin() + this->offsets[set];
+		}
+
+		typename std::vector<csce::point<T>>::const_iterator end(std::size_t set) const {
+			return this->points.begin() + this->offsets[set + 1];
+		}
+	};
+
+
+	/**
+	 * Computes the hulls of every set in a point_batch at once, for inputs made of a very large
+	 * number of small sets. One task per thread of the shared executor takes sets in blocks from a
+	 * shared counter, so sets of uneven sizes balance out. Each set is copied to a per-thread
+	 * scratch buffer, the points inside its extreme point quadrilateral are dropped, and the rest
+	 * are sorted (with insertion sort when there are few) and wrapped by Andrew's monotone chain
+	 * in place, so there are no allocations per set.
+	 *
+	 * Each hull is counterclockwise starting at its left-most point, without repeated or collinear
+	 * points, the same as monotone_chain returns for sets of more than 3 points.
+	 */
+	template<typename T>
+	class batch_hulls {
+	public:
+		batch_hulls(int _nthreads) : pool(csce::shared_executor(_nthreads)) {}
+
+
+		/**
+		 * Writes the hull of every input set to the same set of the output batch.
+		 */
+		void compute_hulls(const csce::point_batch<T>& input, csce::point_batch<T>& output) const {
+			std::size_t sets = input.size();
+
+			//a hull is never larger than its set, so every hull is first written over its set's range of a
+			//buffer as large as the input, and then packed together once the hull sizes are known
+			std::vector<csce::point<T>> unpacked(input.points.size());
+			std::vector<std::size_t> counts(sets);
+			this->run(sets, [&](std::vector<csce::point<T>>& scratch, std::size_t set) {
+				counts[set] = this->hull(input.begin(set), input.end(set), scratch, unpacked.begin() + input.offsets[set]);
+			});
+
+			output.offsets.resize(sets + 1);
+			output.offsets[0] = 0;
+			for(std::size_t x=0; x<sets; x++){
+				output.offsets[x + 1] = output.offsets[x] + counts[x];
+			}
+			output.points.resize(output.offsets[sets]);
+			this->run(sets, [&](std::vector<csce::point<T>>&, std::size_t set) {
+				std::copy(unpacked.begin() + input.offsets[set], unpacked.begin() + input.offsets[set] + counts[set], output.points.begin() + output.offsets[set]);
+			});
+		}
+
+
+		csce::point_batch<T> compute_hulls(const csce::point_batch<T>& input) const {
+			csce::point_batch<T> output;
+			this->compute_hulls(input, output);
+			return output;
+		}
+
+
+	private:
+		std::shared_ptr<csce::executor> pool;
+
+		//the number of sets a thread takes from the counter at a time
+		static const std::size_t block_size = 64;
+
+		//sets up to this size are sorted with insertion sort
+		static const std::size_t insertion_sort_limit = 32;
+
+
+		/**
+		 * Calls work(scratch, set) for every set, spread over the executor's threads.
+		 */
+		template<typename Work>
+		void run(std::size_t sets, Work work) const {
+			std::atomic<std::size_t> next(0);
+			auto worker = [&](std::size_t) {
+				std::vector<csce::point<T>> scratch;
+				while(true){
+					std::size_t start = next.fetch_add(block_size);
+					if(start >= sets){
+						return;
+					}
+					std::size_t stop = std::min(sets, start + block_size);
+					for(std::size_t set=start; set<stop; set++){
+						work(scratch, set);
+					}
+				}
+			};
+
+			std::size_t task_count = std::min<std::size_t>(this->pool->concurrency(), (sets + block_size - 1) / block_size);
+			this->pool->fork_join(task_count, worker);
+		}
+
+
+		/**
+		 * Writes the hull of [begin, end) to output and returns the number of hull points.
+		 */
+		template<typename InputIterator, typename OutputIterator>
+		std::size_t hull(InputIterator begin, InputIterator end, std::vector<csce::point<T>>& scratch, OutputIterator output) const {
+			std::size_t n = end - begin;
+			scratch.resize(2 * n + 1);
+			std::copy(begin, end, scratch.begin());
+			if(n > insertion_sort_limit){
+				n = this->filter(scratch.begin(), scratch.begin() + n) - scratch.begin();
+			}
+
+			auto sorted_begin = scratch.begin();
+			auto sorted_end = scratch.begin() + n;
+			if(n <= insertion_sort_limit){
+				for(auto it = sorted_begin; it != sorted_end; it++){
+					for(auto current = it; current != sorted_begin && csce::monotone_chain<T>::lexicographic_less(*current, *(current - 1)); current--){
+						std::iter_swap(current, current - 1);
+					}
+				}
+			} else {
+				std::sort(sorted_begin, sorted_end, csce::monotone_chain<T>::lexicographic_less);
+			}
+			n = std::unique(sorted_begin, sorted_end) - sorted_begin;
+			if(n <= 2){
+				std::copy(sorted_begin, sorted_begin + n, output);
+				return n;
+			}
+
+			//the chain is built behind the sorted points in the same buffer: lower chain first, then the upper chain backwards
+			csce::point<T>* points = &scratch[0];
+			csce::point<T>* chain = points + n;
+			std::size_t k = 0;
+			for(std::size_t x=0; x<n; x++){
+				while(k >= 2 && csce::monotone_chain<T>::cross(chain[k-2], chain[k-1], points[x]) <= 0){
+					k--;
+				}
+				chain[k++] = points[x];
+			}
+			for(std::size_t x=n-1, lower_size=k+1; x-- > 0; ){
+				while(k >= lower_size && csce::monotone_chain<T>::cross(chain[k-2], chain[k-1], points[x]) <= 0){
+					k--;
+				}
+				chain[k++] = points[x];
+			}
+
+			//the last point is the first point again
+			std::copy(chain, chain + k - 1, output);
+			return k - 1;
+		}
+
+
+		/**
+		 * Moves the points that are not strictly inside the quadrilateral of the left-most, lowest,
+		 * right-most and highest points to the front of [begin, end) and returns the end of them.
+		 * For random sets this leaves only a fraction of the points to sort.
+		 */
+		template<typename Iterator>
+		Iterator filter(Iterator begin, Iterator end) const {
+			csce::point<T> corners[4] = {*begin, *begin, *begin, *begin};
+			for(Iterator it = begin; it != end; it++){
+				if(it->x < corners[0].x){
+					corners[0] = *it;
+				}
+				if(it->y < corners[1].y){
+					corners[1] = *it;
+				}
+				if(it->x > corners[2].x){
+					corners[2] = *it;
+				}
+				if(it->y > corners[3].y){
+					corners[3] = *it;
+				}
+			}
+
+			return std::partition(begin, end, [&](const csce::point<T>& p) {
+				for(int x=0; x<4; x++){
+					if(csce::monotone_chain<T>::cross(corners[x], corners[(x + 1) % 4], p) <= 0){
+						return true;
+					}
+				}
+				return false;
+			});
+		}
+	};
+}
+
+#endif /* batch_hulls_hpp */
@@ -1,168 +1,252 @@
-#ifndef chan_algo_hpp
-#define chan_algo_hpp
-
-#include <vector>
-#include <string>
-#include <utility>
-#include <algorithm>
-#include <iostream>
-#include <stdlib.h>
-
-#include "convex_hull_base.hpp"
-#include "point.hpp"
-#include "vector2d.hpp"
-#include "graham_scan.hpp"
-#include "jarvis_march.hpp"
-
-namespace csce {
-	template<typename T>
-	class chan_algo : public csce::convex_hull_base<T> {
-	public:
-		chan_algo(int _nthreads) : csce::convex_hull_base<T>(_nthreads) {}
-
-
-		std::string name() const {
-			return "Chan's Algorithm Sequential";
-		}
-
-		virtual std::vector<csce::point<T>> compute_hull(std::vector<csce::point<T>>& points) {
-			
-			std::size_t m = points.size() / this->nthreads;
-			
-					std::vector<std::vector<csce::point<T>>> hulls;
-			
-					for(std::size_t i=0; i<points.size(); i=i+m){
-					std::vector<csce::point<T>> chunk;
-				
-					if(points.begin()+i+m <= points.end())
-					chunk.assign(points.begin()+i,points.begin()+i+m);
-				
-					else
-					chunk.assign(points.begin()+i,points.end());
-					
-					hulls.push_back(this->graham_scan(chunk));
-					
-				}	
-			
-			std::vector<csce::point<T>> output;
-				
-					for(std::size_t i=0; i<this->nthreads; i++){
-					    
-						output.insert(output.end(), hulls[i].begin(), hulls[i].end());
-						output = (this->jarvis_march(output));
-					}
-					
-					return output;
-			
-		}
-		
-		~chan_algo() {}
-	
-	private:
-	
-		std::vector<csce::point<T>> graham_scan(std::vector<csce::point<T>>& points) const {
-			if(points.size() <= 3){
-				return points;
-			}
-
-			std::size_t index = this->pivot_index(points);
-			if(index != 0){
-				std::swap(points[0], points[index]);
-			}
-			
-			//sort the points by angle around the pivot point (points[0])
-			std::sort(points.begin() + 1, points.end(), [&points](csce::point<T>& a, csce::point<T>& b) {
-				csce::vector2d<T> pa(points[0], a);
-				csce::vector2d<T> pb(points[0], b);
-				return pa.ccw(pb);
-			});
-			
-			std::vector<csce::point<T>> s;
-			s.reserve(points.size() + 1);
-			
-			s.push_back(points[points.size() - 1]);
-			s.push_back(points[0]);
-			s.push_back(points[1]);
-			
-			int x=2;
-			while(x < points.size()){
-				std::size_t y = s.size() - 1;
-				csce::vector2d<T> a(s[y-1], s[y]);
-				csce::vector2d<T> b(s[y-1], points[x]);
-				if(a.ccw(b)){
-					s.push_back(points[x++]);
-				} else {
-					s.pop_back();
-				}
-			}
-			
-			if(s.front() == s.back()){
-				s.pop_back(); //the polygon is closed, so remove the last element to remove the duplicate point
-			}
-
-			return s;
-		}
-		
-		std::size_t pivot_index(std::vector<csce::point<T>>& points) const {
-			std::size_t index = 0;
-			for(std::size_t x=0; x<points.size(); x++){
-				csce::point<T>& p0 = points[index];
-				csce::point<T>& cur = points[x];
-				if(csce::math_utility::less_than(cur.y, p0.y)){
-					index = x;
-				} else if(csce::math_utility::equals(cur.y, p0.y)){
-					if(csce::math_utility::less_than(cur.x, p0.x)){
-						index = x;
-					}
-				}
-			}
-			return index;
-		}
-		
-		
-		
-		std::vector<csce::point<T>> jarvis_march (const std::vector<csce::point<T>>& points) {
-			std::vector<csce::point<T>> resultsOfShortestPath;
-			int topMostPoint = 0;
-			for(int i = 0; i < points.size(); i++){
-				if(points[i].y > points[topMostPoint].y){
-					topMostPoint = i;
-				}
-			}
-			
-			int tempPoint1 = topMostPoint;
-			int tempPoint2 = 0;
-			int orientationValue = 0;
-			do{
-				tempPoint2 = (tempPoint1 + 1) % points.size();
-				for(int i = 0; i < points.size(); i++){
-					orientationValue = operation(points[tempPoint1],points[i],points[tempPoint2]);
-					if(orientationValue == 2){
-						tempPoint2 = i;
-					}
-				}
-				resultsOfShortestPath.push_back(points[tempPoint2]);
-				tempPoint1 = tempPoint2;
-			}
-			while(tempPoint1 != topMostPoint);
-			
-			return resultsOfShortestPath;
-		}
-		
-		int operation(csce::point<T> d, csce::point<T> e, csce::point<T> f) const {
-			csce::vector2d<T> a(e,d);
-			csce::vector2d<T> b(e,f);
-			bool is_counterclockwise = a.ccw(b);
-			if(is_counterclockwise == true){
-				return 2;
-			}
-			else {
-				return 0;
-			}
-		}
-
-	};
-}
-
-
-#endif /* chan_algo_hpp */
+#ifndef chan_algo_hpp
+#define chan_algo_hpp
+
+#include <vector>
+#include <string>
+#include <utility>
+#include <algorithm>
+#include <limits>
+
+#include "convex_hull_base.hpp"
+#include "point.hpp"
+#include "monotone_chain.hpp"
+
+namespace csce {
+	/**
+	 * Chan's output-sensitive algorithm. The points are split into groups of (at most) m points,
+	 * each group is reduced to a "mini-hull", and then the hull is gift-wrapped for at most m steps.
+	 * Every wrapping step only needs an O(log m) tangent query per mini-hull. If the wrap does not
+	 * close within m steps, the guess for m is squared and the process repeats. The total running
+	 * time is O(n log h).
+	 */
+	template<typename T>
+	class chan_algo : public csce::convex_hull_base<T> {
+	public:
+		using csce::convex_hull_base<T>::compute_hull;
+		
+		chan_algo(int _nthreads) : csce::convex_hull_base<T>(_nthreads) {}
+
+
+		std::string name() const {
+			return "Chan's Algorithm Sequential";
+		}
+
+
+		virtual std::vector<csce::point<T>> compute_hull(std::vector<csce::point<T>>& points) {
+			if(points.size() <= 3){
+				return points;
+			}
+
+			std::vector<csce::point<T>> hull;
+			for(std::size_t t = 1; ; t++){
+				//m = 2^(2^t), capped at n once the guess exceeds the number of points
+				std::size_t m = points.size();
+				if(t < 6 && (static_cast<std::size_t>(1) << (1 << t)) < m){
+					m = static_cast<std::size_t>(1) << (1 << t);
+				}
+
+				std::vector<std::vector<csce::point<T>>> hulls = this->mini_hulls(points, m);
+				if(this->wrap(hulls, m, hull)){
+					return hull;
+				}
+			}
+		}
+
+
+		~chan_algo() {}
+
+
+	protected:
+		/**
+		 * Identifies a vertex by the mini-hull it belongs to and its index in that mini-hull.
+		 */
+		struct vertex {
+			std::size_t hull;
+			std::size_t index;
+			vertex() : hull(std::numeric_limits<std::size_t>::max()), index(0) {}
+			vertex(std::size_t _hull, std::size_t _index) : hull(_hull), index(_index) {}
+			bool valid() const { return this->hull != std::numeric_limits<std::size_t>::max(); }
+		};
+
+
+		/**
+		 * Splits the points into groups of m points and computes the counterclockwise hull of each group.
+		 */
+		virtual std::vector<std::vector<csce::point<T>>> mini_hulls(const std::vector<csce::point<T>>& points, std::size_t m) {
+			std::vector<std::vector<csce::point<T>>> hulls((points.size() + m - 1) / m);
+			for(std::size_t x=0; x<hulls.size(); x++){
+				hulls[x] = this->mini_hull(points, x * m, std::min(points.size(), (x + 1) * m));
+			}
+			return hulls;
+		}
+
+
+		/**
+		 * Finds the next hull vertex after the current vertex by querying the tangent of every mini-hull.
+		 */
+		virtual vertex next_vertex(const std::vector<std::vector<csce::point<T>>>& hulls, const vertex& current) {
+			vertex best;
+			for(std::size_t x=0; x<hulls.size(); x++){
+				vertex candidate = this->tangent(hulls, x, current);
+				if(candidate.valid() && (!best.valid() || this->better(hulls, current, candidate, best))){
+					best = candidate;
+				}
+			}
+			return best;
+		}
+
+
+		std::vector<csce::point<T>> mini_hull(const std::vector<csce::point<T>>& points, std::size_t begin, std::size_t end) const {
+			std::vector<csce::point<T>> chunk(points.begin() + begin, points.begin() + end);
+			std::sort(chunk.begin(), chunk.end(), csce::monotone_chain<T>::lexicographic_less);
+			return csce::monotone_chain<T>::join_chains(csce::monotone_chain<T>::lower_chain(chunk.begin(), chunk.end()), csce::monotone_chain<T>::upper_chain(chunk.begin(), chunk.end()));
+		}
+
+
+		/**
+		 * Returns true if candidate should be chosen over best as the next vertex after current, which
+		 * is the case if it is clockwise from best or collinear with it but farther away.
+		 */
+		bool better(const std::vector<std::vector<csce::point<T>>>& hulls, const vertex& current, const vertex& candidate, const vertex& best) const {
+			const csce::point<T>& p = hulls[current.hull][current.index];
+			return this->better(p, hulls[candidate.hull][candidate.index], hulls[best.hull][best.index]);
+		}
+
+
+		/**
+		 * Finds the vertex of the given mini-hull such that the whole mini-hull is to the left of (or on)
+		 * the line from the current vertex to it. Returns an invalid vertex if the mini-hull only consists
+		 * of the current point.
+		 */
+		vertex tangent(const std::vector<std::vector<csce::point<T>>>& hulls, std::size_t h, const vertex& current) const {
+			const std::vector<csce::point<T>>& hull = hulls[h];
+			const csce::point<T>& p = hulls[current.hull][current.index];
+			std::size_t n = hull.size();
+
+			if(h == current.hull){
+				//the current vertex is on this mini-hull, so its tangent is the next counterclockwise vertex
+				return n > 1 ? vertex(h, (current.index + 1) % n) : vertex();
+			}
+
+			if(n > 4){
+				std::size_t index = this->tangent_search(hull, p);
+				if(hull[index] != p && !this->right_of(p, hull[index], hull[(index + 1) % n]) && !this->right_of(p, hull[index], hull[(index + n - 1) % n])){
+					//collinear neighbours are on the same ray, so prefer the farther one
+					std::size_t best = index;
+					for(std::size_t neighbour : { (index + 1) % n, (index + n - 1) % n }){
+						if(this->better(p, hull[neighbour], hull[best])){
+							best = neighbour;
+						}
+					}
+					return vertex(h, best);
+				}
+			}
+
+			//small hulls, or degenerate cases (such as duplicates of the current point), use a linear scan
+			vertex best;
+			for(std::size_t x=0; x<n; x++){
+				if(hull[x] != p && (!best.valid() || this->better(p, hull[x], hull[best.index]))){
+					best = vertex(h, x);
+				}
+			}
+			return best;
+		}
+
+
+	private:
+
+		/**
+		 * Gift-wraps the mini-hulls for at most m steps starting from the lowest (then left-most) point.
+		 * Returns true and fills the hull if the wrap closed in time.
+		 */
+		bool wrap(const std::vector<std::vector<csce::point<T>>>& hulls, std::size_t m, std::vector<csce::point<T>>& hull) {
+			vertex start;
+			for(std::size_t x=0; x<hulls.size(); x++){
+				for(std::size_t y=0; y<hulls[x].size(); y++){
+					const csce::point<T>& p = hulls[x][y];
+					if(!start.valid()){
+						start = vertex(x, y);
+						continue;
+					}
+					const csce::point<T>& s = hulls[start.hull][start.index];
+					if(p.y < s.y || (p.y == s.y && p.x < s.x)){
+						start = vertex(x, y);
+					}
+				}
+			}
+
+			hull.clear();
+			hull.push_back(hulls[start.hull][start.index]);
+
+			vertex current = start;
+			for(std::size_t step = 0; step < m; step++){
+				vertex next = this->next_vertex(hulls, current);
+				if(!next.valid() || hulls[next.hull][next.index] == hull.front()){
+					return true;
+				}
+				hull.push_back(hulls[next.hull][next.index]);
+				current = next;
+			}
+			return false;
+		}
+
+
+		/**
+		 * Binary search for the most clockwise vertex of a counterclockwise convex polygon as seen
+		 * from an exterior point p (see Dan Sunday's tangent_PointPolyC).
+		 */
+		std::size_t tangent_search(const std::vector<csce::point<T>>& hull, const csce::point<T>& p) const {
+			std::size_t n = hull.size();
+			auto above = [&](std::size_t i, std::size_t j) { return csce::monotone_chain<T>::cross(p, hull[i % n], hull[j % n]) > 0; };
+			auto below = [&](std::size_t i, std::size_t j) { return csce::monotone_chain<T>::cross(p, hull[i % n], hull[j % n]) < 0; };
+
+			if(below(1, 0) && !above(n - 1, 0)){
+				return 0;
+			}
+
+			std::size_t a = 0, b = n;
+			while(true){
+				if(b - a == 1){
+					return above(a, b) ? a : b % n;
+				}
+
+				std::size_t c = (a + b) / 2;
+				bool down_c = below(c + 1, c);
+				if(down_c && !above(c - 1, c)){
+					return c;
+				}
+
+				if(above(a + 1, a)){
+					if(down_c || above(a, c)){
+						b = c;
+					} else {
+						a = c;
+					}
+				} else {
+					if(!down_c || !below(a, c)){
+						a = c;
+					} else {
+						b = c;
+					}
+				}
+			}
+		}
+
+
+		bool right_of(const csce::point<T>& p, const csce::point<T>& q, const csce::point<T>& r) const {
+			return csce::monotone_chain<T>::cross(p, q, r) < 0;
+		}
+
+
+		bool better(const csce::point<T>& p, const csce::point<T>& candidate, const csce::point<T>& best) const {
+			typename csce::orientation::wide<T>::type turn = csce::monotone_chain<T>::cross(p, best, candidate);
+			if(turn != 0){
+				return turn < 0;
+			}
+			return csce::orientation::squared_distance(p, candidate) > csce::orientation::squared_distance(p, best);
+		}
+	};
+}
+
+
+#endif /* chan_algo_hpp */
@@ -4,9 +4,10 @@
 #include <vector>
 #include <string>
 #include <utility>
-#include <omp.h>
+#include <algorithm>
 #include <math.h>
 #include <sstream>
+#include <memory>
 
 #include "convex_hull_base.hpp"
 #include "graham_scan_parallel.hpp"
@@ -20,6 +21,8 @@ namespace csce
 	class composable_hulls : public csce::convex_hull_base<T>
 	{
 	public:
+		using csce::convex_hull_base<T>::compute_hull;
+		
 		composable_hulls(int _nthreads) : convex_hull_base<T>(_nthreads) {}
 		~composable_hulls() {}
 		
@@ -30,28 +33,34 @@ namespace csce
 		
 		virtual std::vector<csce::point<T>> compute_hull(std::vector<csce::point<T>> &points)
 		{
-			std::vector<std::vector<csce::point<T>>> sectors(this->nthreads);
-			std::vector<std::vector<csce::point<T>>> hulls(this->nthreads);
-			double secSize = M_PI / this->nthreads;
+			csce::scratch_arena::scope scope(this->scratch());
+			size_t sectorCount = this->nthreads;
+			double secSize = M_PI / sectorCount;
 			size_t topMostPoint = 0;
 			
-			#pragma omp parallel num_threads(this->nthreads)
+			// the sector buffers and the local hull algorithms are kept between calls, so their memory is reused
+			this->sectors.resize(sectorCount);
+			this->hulls.resize(sectorCount);
+			while(this->localAlgorithms.size() < sectorCount)
+				this->localAlgorithms.push_back(std::unique_ptr<U>(new U(1)));
+			
+			// find top-most point (before the threads start, since they all read it)
+			for(size_t i = 0; i < points.size(); i++)
 			{
-				std::vector<std::vector<csce::point<T>>> localSectors(this->nthreads);
-				
-				// find top-most point
-				#pragma omp for
-				for(size_t i = 0; i < points.size(); i++)
+				if(points[i].y > points[topMostPoint].y)
 				{
-					if(points[i].y > points[topMostPoint].y)
-					{
-						topMostPoint = i;
-					}
+					topMostPoint = i;
 				}
-				
-				// split points up by sector
-				#pragma omp for
-				for(size_t i = 0; i < points.size(); i++)
+			}
+			
+			// find every point's sector, and count the points of each sector in each chunk of the points
+			std::size_t chunks = this->executor().chunk_count(points.size(), 1);
+			csce::arena_allocator<std::size_t> allocator(&this->scratch());
+			csce::scratch_vector<std::size_t> sectorOf(points.size(), 0, allocator);
+			csce::scratch_vector<std::size_t> offsets(chunks * sectorCount, 0, allocator);
+			this->executor().parallel_for(points.size(), 1, [&](std::size_t chunk, std::size_t begin, std::size_t end)
+			{
+				for(size_t i = begin; i < end; i++)
 				{
 					double theta = atan2(points[topMostPoint].y - points[i].y, points[topMostPoint].x - points[i].x);
 					if(theta < 0)
@@ -61,31 +70,56 @@ namespace csce
 						else
 							theta = M_PI - 1e-9;
 					}
-					size_t sector = theta / secSize;
-					localSectors[sector].push_back(points[i]);
+					// points level with the top-most point to its right have theta == pi
+					size_t sector = std::min(static_cast<size_t>(theta / secSize), sectorCount - 1);
+					sectorOf[i] = sector;
+					offsets[chunk * sectorCount + sector]++;
 				}
+			});
+			
+			// group the points by sector, keeping the chunks in order within a sector
+			csce::scratch_vector<std::size_t> sectorStart(sectorCount + 1, 0, allocator);
+			size_t offset = 0;
+			for(size_t sector = 0; sector < sectorCount; sector++)
+			{
+				sectorStart[sector] = offset;
+				for(size_t chunk = 0; chunk < chunks; chunk++)
+				{
+					size_t count = offsets[chunk * sectorCount + sector];
+					offsets[chunk * sectorCount + sector] = offset;
+					offset += count;
+				}
+			}
+			sectorStart[sectorCount] = offset;
+			
+			csce::scratch_vector<csce::point<T>> grouped(points.size(), csce::point<T>(), csce::arena_allocator<csce::point<T>>(&this->scratch()));
+			this->executor().parallel_for(points.size(), 1, [&](std::size_t chunk, std::size_t begin, std::size_t end)
+			{
+				for(size_t i = begin; i < end; i++)
+					grouped[offsets[chunk * sectorCount + sectorOf[i]]++] = points[i];
+			});
+			
+			// compute each sector's local convex hull
+			this->executor().fork_join(sectorCount, [&](std::size_t id)
+			{
+				this->sectors[id].assign(grouped.begin() + sectorStart[id], grouped.begin() + sectorStart[id + 1]);
 				
-				#pragma omp critical
-				for(size_t i = 0; i < this->nthreads; i++)
-					sectors[i].insert(sectors[i].end(), localSectors[i].begin(), localSectors[i].end());
-				
-				#pragma omp barrier
-				// local convex hull
-				size_t id = omp_get_thread_num();
-				if(sectors[id].size() > 2)
-					hulls[id] = U(1).compute_hull(sectors[id]);
+				if(this->sectors[id].size() > 2)
+					this->hulls[id] = this->localAlgorithms[id]->compute_hull(this->sectors[id]);
 				else
-					hulls[id] = sectors[id]; // not actually a hull, but the points may be in the final hull
-			}
+					this->hulls[id] = this->sectors[id]; // not actually a hull, but the points may be in the final hull
+			});
 			
 			// composition of local hulls
-			std::vector<csce::point<T>> resultsOfShortestPath = hulls[0];
+			std::vector<csce::point<T>> resultsOfShortestPath = this->hulls[0];
 			V combiner(this->nthreads);
-			for(size_t i = 1; i < this->nthreads; i++)
+			combiner.set_executor(this->pool);
+			combiner.set_arena(this->get_arena());
+			for(size_t i = 1; i < sectorCount; i++)
 			{
-				if(hulls[i].size() > 0)
+				if(this->hulls[i].size() > 0)
 				{
-					resultsOfShortestPath.insert(resultsOfShortestPath.end(), hulls[i].begin(), hulls[i].end());
+					resultsOfShortestPath.insert(resultsOfShortestPath.end(), this->hulls[i].begin(), this->hulls[i].end());
 					resultsOfShortestPath = combiner.compute_hull(resultsOfShortestPath);
 				}
 			}
@@ -94,6 +128,10 @@ namespace csce
 		}
 		
 	private:
+		std::vector<std::vector<csce::point<T>>> sectors;
+		std::vector<std::vector<csce::point<T>>> hulls;
+		std::vector<std::unique_ptr<U>> localAlgorithms; // one per sector, since the sectors are computed at the same time
+		
 		int operation(csce::point<T> d, csce::point<T> e, csce::point<T> f) const
 		{
 			int resultsofSin = (e.y - d.y) * (f.x - e.x) - (e.x - d.x) * (f.y - e.y);
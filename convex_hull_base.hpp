@@ -3,8 +3,16 @@
 
 #include <vector>
 #include <string>
+#include <memory>
+#include <algorithm>
+#include <unordered_map>
+#include <limits>
 
 #include "point.hpp"
+#include "point_cloud.hpp"
+#include "point_span.hpp"
+#include "executor.hpp"
+#include "scratch_arena.hpp"
 
 namespace csce {
 	template<typename T>
@@ -13,11 +21,121 @@ namespace csce {
 		virtual std::string name() const = 0;
 		virtual std::vector<csce::point<T>> compute_hull(std::vector<csce::point<T>>& points) = 0;
 		
+		/**
+		 * Computes the hull of points stored as separate x and y arrays (a point_cloud or a view of
+		 * part of one). Implementations that do not work on the arrays directly get a copy of the
+		 * points as a vector. Every implementation declares using convex_hull_base<T>::compute_hull,
+		 * since its own compute_hull would otherwise hide this overload and the span one.
+		 */
+		virtual std::vector<csce::point<T>> compute_hull(const csce::point_cloud_view<T>& points) {
+			std::vector<csce::point<T>> copy = points.to_vector();
+			return this->compute_hull(copy);
+		}
+		
+		/**
+		 * Computes the hull of points that must not change, such as a memory-mapped file. The
+		 * points are never written to. Implementations that reorder their input work on an
+		 * internal copy instead, which is kept between calls so that it is only allocated once;
+		 * the others read the span directly.
+		 */
+		virtual std::vector<csce::point<T>> compute_hull(const csce::point_span<T>& points) {
+			this->input_copy.assign(points.begin(), points.end());
+			return this->compute_hull(this->input_copy);
+		}
+		
+		/**
+		 * Computes the hull like compute_hull, but returns the indices of its vertices in points
+		 * instead of copies of them, in the same order. A vertex that occurs in points more than
+		 * once gets the index of its first copy.
+		 */
+		std::vector<std::size_t> compute_hull_indices(const csce::point_span<T>& points) {
+			std::vector<csce::point<T>> hull = this->compute_hull(points);
+			const std::size_t missing = std::numeric_limits<std::size_t>::max();
+			
+			std::unordered_map<csce::point<T>, std::size_t> index;
+			index.reserve(hull.size());
+			for(auto& p : hull){
+				index.emplace(p, missing);
+			}
+			
+			//one pass over the points, which stops as soon as every vertex has been seen
+			std::size_t found = 0;
+			for(std::size_t x=0; x<points.size() && found < index.size(); x++){
+				auto vertex = index.find(points[x]);
+				if(vertex != index.end() && vertex->second == missing){
+					vertex->second = x;
+					found++;
+				}
+			}
+			if(found < index.size()){
+				throw "compute_hull_indices: a hull vertex is not one of the points";
+			}
+			
+			std::vector<std::size_t> indices;
+			indices.reserve(hull.size());
+			for(auto& p : hull){
+				indices.push_back(index[p]);
+			}
+			return indices;
+		}
+		
+		/**
+		 * Optional statistics about the last call to compute_hull, or an empty string if
+		 * the implementation has nothing to report.
+		 */
+		virtual std::string summary() const { return ""; }
+		
 		virtual ~convex_hull_base() {}
-		convex_hull_base(int _nthreads) : nthreads(_nthreads) {}
+		
+		/**
+		 * Runs on the persistent shared executor with _nthreads threads (see shared_executor).
+		 */
+		convex_hull_base(int _nthreads) : nthreads(std::max(1, _nthreads)), pool(csce::shared_executor(_nthreads)) {}
+		
+		/**
+		 * Makes the algorithm run its parallel parts on the given executor from now on.
+		 */
+		void set_executor(const std::shared_ptr<csce::executor>& _pool) {
+			this->pool = _pool;
+			this->nthreads = _pool->concurrency();
+		}
+		
+		const std::shared_ptr<csce::executor>& get_executor() const {
+			return this->pool;
+		}
+		
+		/**
+		 * Makes the algorithm take its temporary buffers from the given arena. Otherwise every algorithm
+		 * creates its own the first time it needs one. Algorithms that call each other on the same
+		 * thread can share one.
+		 */
+		void set_arena(const std::shared_ptr<csce::scratch_arena>& _arena) {
+			this->arena = _arena;
+		}
+		
+		const std::shared_ptr<csce::scratch_arena>& get_arena() const {
+			this->scratch();
+			return this->arena;
+		}
 		
 	protected:
-		int nthreads = 0;
+		//the concurrency of the executor, which the algorithms use to decide how to split their work
+		int nthreads = 1;
+		std::shared_ptr<csce::executor> pool;
+		mutable std::shared_ptr<csce::scratch_arena> arena;
+		//the copy of a point_span for implementations that reorder their input
+		std::vector<csce::point<T>> input_copy;
+		
+		csce::executor& executor() const {
+			return *this->pool;
+		}
+		
+		csce::scratch_arena& scratch() const {
+			if(!this->arena){
+				this->arena = std::make_shared<csce::scratch_arena>();
+			}
+			return *this->arena;
+		}
 	};
 }
 
@@ -13,6 +13,12 @@
 #include "composable_hulls.hpp"
 #include "quick_hull.hpp"
 #include "quick_hull_parallel.hpp"
+#include "quick_hull_inplace.hpp"
+#include "monotone_chain.hpp"
+#include "monotone_chain_parallel.hpp"
+#include "akl_toussaint.hpp"
+#include "divide_and_conquer.hpp"
+#include "kirkpatrick_seidel.hpp"
 
 namespace csce {
 	namespace convex_hull_implementations {
@@ -29,10 +35,18 @@ namespace csce {
 			algorithms.push_back(new csce::graham_scan_parallel<T>(thread_count));
 			algorithms.push_back(new csce::jarvis_march<T>(thread_count));
 			algorithms.push_back(new csce::jarvis_march_parallel<T>(thread_count));
-			// algorithms.push_back(new csce::chan_algo_parallel<T>(thread_count));
+			algorithms.push_back(new csce::chan_algo_parallel<T>(thread_count));
 			algorithms.push_back(new csce::chan_algo<T>(thread_count));
 			algorithms.push_back(new csce::quick_hull<T>(thread_count));
 			algorithms.push_back(new csce::quick_hull_parallel<T>(thread_count));
+			algorithms.push_back(new csce::quick_hull_inplace<T>(thread_count));
+			algorithms.push_back(new csce::monotone_chain<T>(thread_count));
+			algorithms.push_back(new csce::monotone_chain_parallel<T>(thread_count));
+			algorithms.push_back(new csce::divide_and_conquer<T>(thread_count));
+			algorithms.push_back(new csce::kirkpatrick_seidel<T>(thread_count));
+			algorithms.push_back(new csce::akl_toussaint<T, csce::graham_scan<T>>(thread_count));
+			algorithms.push_back(new csce::akl_toussaint<T, csce::quick_hull<T>>(thread_count));
+			algorithms.push_back(new csce::akl_toussaint<T, csce::jarvis_march<T>>(thread_count));
 			
 			return algorithms;
 		}
@@ -0,0 +1,87 @@
+#ifndef divide_and_conquer_hpp
+#define divide_and_conquer_hpp
+
+#include <vector>
+#include <string>
+#include <algorithm>
+
+#include "convex_hull_base.hpp"
+#include "point.hpp"
+#include "monotone_chain.hpp"
+#include "monotone_chain_parallel.hpp"
+#include "hull_merge.hpp"
+
+namespace csce {
+	/**
+	 * Preparata-Hong style divide and conquer. The points are sorted by x and cut into one
+	 * slab per thread, each slab's hull is computed independently, and neighbouring hulls
+	 * are merged at their upper and lower bridges. The merges form a reduction tree of
+	 * depth log(p), and all of the merges on one level of the tree run in parallel.
+	 */
+	template<typename T>
+	class divide_and_conquer : public csce::convex_hull_base<T> {
+	public:
+		using csce::convex_hull_base<T>::compute_hull;
+		
+		divide_and_conquer(int _nthreads) : csce::convex_hull_base<T>(_nthreads) {}
+
+
+		std::string name() const {
+			return "Divide and Conquer";
+		}
+
+
+		virtual std::vector<csce::point<T>> compute_hull(std::vector<csce::point<T>>& points) {
+			if(points.size() <= 3){
+				return points;
+			}
+
+			csce::scratch_arena::scope scope(this->scratch());
+			csce::monotone_chain_parallel<T>::sort_array(points, this->executor(), &this->scratch());
+
+			//cut the sorted points into slabs, never splitting points that share an x coordinate
+			std::size_t slab_count = std::max<std::size_t>(1, std::min<std::size_t>(this->nthreads, points.size() / minimum_slab));
+			std::vector<std::size_t> bounds(1, 0);
+			for(std::size_t x=1; x<slab_count; x++){
+				std::size_t bound = std::max(bounds.back(), points.size() * x / slab_count);
+				while(bound > 0 && bound < points.size() && points[bound].x == points[bound - 1].x){
+					bound++;
+				}
+				if(bound > bounds.back() && bound < points.size()){
+					bounds.push_back(bound);
+				}
+			}
+			bounds.push_back(points.size());
+
+			std::vector<csce::hull_chains<T>> hulls(bounds.size() - 1);
+			this->executor().fork_join(hulls.size(), [&](std::size_t x) {
+				hulls[x] = csce::hull_merge::from_sorted<T>(points.begin() + bounds[x], points.begin() + bounds[x+1]);
+			});
+
+			//merge neighbouring hulls pairwise until one is left
+			while(hulls.size() > 1){
+				std::vector<csce::hull_chains<T>> merged((hulls.size() + 1) / 2);
+				this->executor().fork_join(merged.size(), [&](std::size_t x) {
+					if(2 * x + 1 < hulls.size()){
+						merged[x] = csce::hull_merge::merge(hulls[2 * x], hulls[2 * x + 1]);
+					} else {
+						merged[x] = std::move(hulls[2 * x]);
+					}
+				});
+				hulls.swap(merged);
+			}
+
+			return csce::hull_merge::to_polygon(hulls.front());
+		}
+
+
+		~divide_and_conquer() {}
+
+
+	private:
+		//slabs smaller than this are not worth a separate task
+		static const std::size_t minimum_slab = 1024;
+	};
+}
+
+#endif /* divide_and_conquer_hpp */
@@ -0,0 +1,382 @@
+#ifndef dynamic_hull_hpp
+#define dynamic_hull_hpp
+
+#include <vector>
+#include <memory>
+#include <random>
+
+#include "point.hpp"
+#include "vector2d.hpp"
+#include "monotone_chain.hpp"
+
+namespace csce {
+	/**
+	 * A convex hull that supports inserting and erasing points, after Overmars and van Leeuwen.
+	 *
+	 * The points are kept in a treap ordered lexicographically. Every treap node stores the
+	 * lower and upper chains of the points in its subtree, which are its left child's chains,
+	 * its own point and its right child's chains joined at their bridges. The chains are
+	 * persistent treaps themselves, so joining two chains shares their nodes instead of copying
+	 * them, and the children keep their own chains. Bridges are found by descending both chains
+	 * (O(log(n)^2)), so an update, which rebuilds the chains along one path of the tree, takes
+	 * O(log(n)^3) expected time.
+	 *
+	 * Points are a multiset: inserting a point twice needs two erases to remove it.
+	 */
+	template<typename T>
+	class dynamic_hull {
+	public:
+		dynamic_hull() {}
+
+
+		template<typename Iterator>
+		dynamic_hull(Iterator begin, Iterator end) {
+			this->update(begin, end, end, end);
+		}
+
+
+		void insert(const csce::point<T>& p) {
+			this->insert(this->root, p);
+			this->count++;
+			this->rebuild(this->root);
+		}
+
+
+		/**
+		 * Removes one copy of p. Returns false if p was not in the hull's point set.
+		 */
+		bool erase(const csce::point<T>& p) {
+			bool found = this->erase(this->root, p);
+			if(found){
+				this->count--;
+				this->rebuild(this->root);
+			}
+			return found;
+		}
+
+
+		/**
+		 * Inserts [insert_begin, insert_end) and then erases [erase_begin, erase_end). The chains of
+		 * every changed tree node are rebuilt once, after all of the points have been applied.
+		 * Returns the number of erased points that were found.
+		 */
+		template<typename InsertIterator, typename EraseIterator>
+		std::size_t update(InsertIterator insert_begin, InsertIterator insert_end, EraseIterator erase_begin, EraseIterator erase_end) {
+			for(InsertIterator it = insert_begin; it != insert_end; it++){
+				this->insert(this->root, *it);
+				this->count++;
+			}
+
+			std::size_t erased = 0;
+			for(EraseIterator it = erase_begin; it != erase_end; it++){
+				if(this->erase(this->root, *it)){
+					this->count--;
+					erased++;
+				}
+			}
+
+			this->rebuild(this->root);
+			return erased;
+		}
+
+
+		/**
+		 * Returns the hull as a counterclockwise polygon starting at the left-most point.
+		 */
+		std::vector<csce::point<T>> hull() const {
+			std::vector<csce::point<T>> lower;
+			std::vector<csce::point<T>> upper;
+			if(this->root){
+				this->flatten(this->root->lower, lower);
+				this->flatten(this->root->upper, upper);
+			}
+			return csce::monotone_chain<T>::join_chains(lower, upper);
+		}
+
+
+		/**
+		 * The number of points, counting repeated points once per insert.
+		 */
+		std::size_t size() const {
+			return this->count;
+		}
+
+
+		bool empty() const {
+			return this->count == 0;
+		}
+
+
+		void clear() {
+			this->root.reset();
+			this->count = 0;
+		}
+
+
+	private:
+		struct chain_node;
+		typedef std::shared_ptr<const chain_node> chain;
+
+		/**
+		 * A node of a persistent chain treap. Nodes are never modified once they are built.
+		 */
+		struct chain_node {
+			csce::point<T> value;
+			csce::point<T> first; //the left-most point of the subtree
+			unsigned int priority;
+			chain left;
+			chain right;
+
+			chain_node(const csce::point<T>& _value, unsigned int _priority, const chain& _left, const chain& _right) : value(_value), first(_left ? _left->first : _value), priority(_priority), left(_left), right(_right) {}
+		};
+
+		struct node {
+			csce::point<T> p;
+			std::size_t copies = 1;
+			unsigned int priority;
+			bool dirty = true;
+			std::unique_ptr<node> left;
+			std::unique_ptr<node> right;
+			chain lower;
+			chain upper;
+
+			node(const csce::point<T>& _p, unsigned int _priority) : p(_p), priority(_priority) {}
+		};
+
+		std::unique_ptr<node> root;
+		std::size_t count = 0;
+		std::mt19937 random;
+
+
+		/**
+		 * Returns +1 if o, a, b make a counterclockwise turn, -1 if they make a clockwise turn and 0 if they are collinear.
+		 */
+		static int orientation(const csce::point<T>& o, const csce::point<T>& a, const csce::point<T>& b) {
+			return csce::vector2d<T>(o, a).orientation(csce::vector2d<T>(o, b));
+		}
+
+
+		/**
+		 * Adds p below t without rebuilding any chains. Returns true if a tree node was added.
+		 */
+		bool insert(std::unique_ptr<node>& t, const csce::point<T>& p) {
+			if(!t){
+				t.reset(new node(p, this->random()));
+				return true;
+			}
+			if(p == t->p){
+				t->copies++;
+				return false;
+			}
+
+			bool less = csce::monotone_chain<T>::lexicographic_less(p, t->p);
+			std::unique_ptr<node>& child = less ? t->left : t->right;
+			if(!this->insert(child, p)){
+				return false;
+			}
+			t->dirty = true;
+			if(child->priority > t->priority){
+				if(less){
+					this->rotate_right(t);
+				} else {
+					this->rotate_left(t);
+				}
+			}
+			return true;
+		}
+
+
+		/**
+		 * Removes one copy of p below t without rebuilding any chains. Returns false if p was not found.
+		 */
+		bool erase(std::unique_ptr<node>& t, const csce::point<T>& p) {
+			if(!t){
+				return false;
+			}
+			if(p == t->p){
+				if(t->copies > 1){
+					t->copies--;
+				} else {
+					this->remove(t);
+				}
+				return true;
+			}
+
+			std::unique_ptr<node>& child = csce::monotone_chain<T>::lexicographic_less(p, t->p) ? t->left : t->right;
+			bool found = this->erase(child, p);
+			if(found){
+				t->dirty = true;
+			}
+			return found;
+		}
+
+
+		/**
+		 * Rotates the node t down until it is a leaf and removes it.
+		 */
+		void remove(std::unique_ptr<node>& t) {
+			if(!t->left && !t->right){
+				t.reset();
+				return;
+			}
+
+			if(!t->right || (t->left && t->left->priority > t->right->priority)){
+				this->rotate_right(t);
+				this->remove(t->right);
+			} else {
+				this->rotate_left(t);
+				this->remove(t->left);
+			}
+		}
+
+
+		void rotate_right(std::unique_ptr<node>& t) {
+			std::unique_ptr<node> pivot = std::move(t->left);
+			t->left = std::move(pivot->right);
+			t->dirty = true;
+			pivot->right = std::move(t);
+			pivot->dirty = true;
+			t = std::move(pivot);
+		}
+
+
+		void rotate_left(std::unique_ptr<node>& t) {
+			std::unique_ptr<node> pivot = std::move(t->right);
+			t->right = std::move(pivot->left);
+			t->dirty = true;
+			pivot->left = std::move(t);
+			pivot->dirty = true;
+			t = std::move(pivot);
+		}
+
+
+		/**
+		 * Rebuilds the chains of every dirty node below t, children first.
+		 */
+		void rebuild(std::unique_ptr<node>& t) {
+			if(!t || !t->dirty){
+				return;
+			}
+			this->rebuild(t->left);
+			this->rebuild(t->right);
+
+			chain single = std::make_shared<const chain_node>(t->p, this->random(), chain(), chain());
+			t->lower = single;
+			t->upper = single;
+			if(t->left){
+				t->lower = this->merge(t->left->lower, t->lower, -1);
+				t->upper = this->merge(t->left->upper, t->upper, 1);
+			}
+			if(t->right){
+				t->lower = this->merge(t->lower, t->right->lower, -1);
+				t->upper = this->merge(t->upper, t->right->upper, 1);
+			}
+			t->dirty = false;
+		}
+
+
+		/**
+		 * Joins two chains where every point of left comes before every point of right at their bridge.
+		 * side is 1 for upper chains and -1 for lower chains. This is the same search as
+		 * hull_merge::bridge, done by descending the chain treaps instead of by index.
+		 */
+		chain merge(const chain& left, const chain& right, int side) const {
+			//the first left point where the next one is not strictly outside of the tangent line
+			csce::point<T> a = this->search(left, [&](const csce::point<T>& p, const csce::point<T>& next) {
+				return side * orientation(p, this->tangent(right, p, side), next) > 0;
+			});
+			csce::point<T> b = this->tangent(right, a, side);
+			return this->join(this->prefix(left, a), this->suffix(right, b));
+		}
+
+
+		/**
+		 * The point of the chain where the tangent line from p (left of the chain) touches it.
+		 */
+		csce::point<T> tangent(const chain& c, const csce::point<T>& p, int side) const {
+			return this->search(c, [&](const csce::point<T>& q, const csce::point<T>& next) {
+				return side * orientation(p, q, next) >= 0;
+			});
+		}
+
+
+		/**
+		 * Returns the first point of the chain for which move_right(point, next point) is false,
+		 * or the last point if there is none. move_right must be true for a prefix of the chain.
+		 */
+		template<typename Predicate>
+		csce::point<T> search(const chain& c, Predicate move_right) const {
+			const chain_node* current = c.get();
+			const chain_node* successor = nullptr; //the next point after the current subtree
+			const chain_node* answer = nullptr;
+			while(current){
+				const csce::point<T>* next = current->right ? &current->right->first : (successor ? &successor->value : nullptr);
+				if(next && move_right(current->value, *next)){
+					current = current->right.get();
+				} else {
+					answer = current;
+					successor = current;
+					current = current->left.get();
+				}
+			}
+			return answer->value;
+		}
+
+
+		/**
+		 * The points of the chain up to and including p.
+		 */
+		chain prefix(const chain& c, const csce::point<T>& p) const {
+			if(!c){
+				return c;
+			}
+			if(csce::monotone_chain<T>::lexicographic_less(p, c->value)){
+				return this->prefix(c->left, p);
+			}
+			return std::make_shared<const chain_node>(c->value, c->priority, c->left, this->prefix(c->right, p));
+		}
+
+
+		/**
+		 * The points of the chain from p onwards.
+		 */
+		chain suffix(const chain& c, const csce::point<T>& p) const {
+			if(!c){
+				return c;
+			}
+			if(csce::monotone_chain<T>::lexicographic_less(c->value, p)){
+				return this->suffix(c->right, p);
+			}
+			return std::make_shared<const chain_node>(c->value, c->priority, this->suffix(c->left, p), c->right);
+		}
+
+
+		/**
+		 * Concatenates two chains, where every point of left comes before every point of right.
+		 */
+		chain join(const chain& left, const chain& right) const {
+			if(!left){
+				return right;
+			}
+			if(!right){
+				return left;
+			}
+			if(left->priority > right->priority){
+				return std::make_shared<const chain_node>(left->value, left->priority, left->left, this->join(left->right, right));
+			}
+			return std::make_shared<const chain_node>(right->value, right->priority, this->join(left, right->left), right->right);
+		}
+
+
+		void flatten(const chain& c, std::vector<csce::point<T>>& output) const {
+			if(!c){
+				return;
+			}
+			this->flatten(c->left, output);
+			output.push_back(c->value);
+			this->flatten(c->right, output);
+		}
+	};
+}
+
+#endif /* dynamic_hull_hpp */
@@ -0,0 +1,77 @@
+#include "executor.hpp"
+#include "task_scheduler.hpp"
+
+#include <algorithm>
+#include <map>
+#include <mutex>
+
+void csce::executor::fork_join(std::size_t count, const std::function<void(std::size_t)>& body) {
+	if(count == 0){
+		return;
+	}
+
+	task_group group;
+	std::exception_ptr error;
+	try {
+		for(std::size_t x=1; x<count; x++){
+			this->spawn(group, [&body, x]() { body(x); });
+		}
+		body(0);
+	} catch(...) {
+		error = std::current_exception();
+	}
+
+	//the spawned tasks refer to body, so they have to finish before this returns, even by throwing
+	try {
+		this->wait(group);
+	} catch(...) {
+		if(!error){
+			error = std::current_exception();
+		}
+	}
+	if(error){
+		std::rethrow_exception(error);
+	}
+}
+
+std::size_t csce::executor::chunk_count(std::size_t count, std::size_t grain) const {
+	std::size_t chunks = std::min<std::size_t>(std::max(1, this->concurrency()), count / std::max<std::size_t>(1, grain));
+	return std::max<std::size_t>(1, chunks);
+}
+
+void csce::executor::parallel_for(std::size_t count, std::size_t grain, const std::function<void(std::size_t, std::size_t, std::size_t)>& body) {
+	std::size_t chunks = this->chunk_count(count, grain);
+	this->fork_join(chunks, [&](std::size_t chunk) {
+		body(chunk, count * chunk / chunks, count * (chunk + 1) / chunks);
+	});
+}
+
+int csce::serial_executor::concurrency() const {
+	return 1;
+}
+
+void csce::serial_executor::spawn(task_group& group, std::function<void()> task) {
+	add_task(group);
+	run_task(group, task);
+}
+
+void csce::serial_executor::wait(task_group& group) {
+	rethrow(group); //every task ran when it was spawned
+}
+
+std::shared_ptr<csce::executor> csce::shared_executor(int nthreads) {
+	static std::mutex mutex;
+	static std::map<int, std::shared_ptr<csce::executor>> executors;
+
+	nthreads = std::max(1, nthreads);
+	std::lock_guard<std::mutex> lock(mutex);
+	std::shared_ptr<csce::executor>& pool = executors[nthreads];
+	if(!pool){
+		if(nthreads == 1){
+			pool = std::make_shared<csce::serial_executor>();
+		} else {
+			pool = std::make_shared<csce::task_scheduler>(nthreads);
+		}
+	}
+	return pool;
+}
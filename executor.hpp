@@ -0,0 +1,135 @@
+#ifndef executor_hpp
+#define executor_hpp
+
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <exception>
+
+namespace csce {
+	/**
+	 * Runs the parallel parts of the hull algorithms. Tasks are forked into a task_group and joined by
+	 * waiting on the group; parallel_for and fork_join are built on top of that. A thread that waits
+	 * on a group must keep running tasks instead of blocking, so that tasks can fork and join their
+	 * own children on the same executor without deadlocking. Tasks must therefore never wait for
+	 * each other in any other way (no barriers between sibling tasks).
+	 *
+	 * A task that throws does not take its thread down: the exception is kept by its group, and the
+	 * first one is rethrown from wait() once every task of the group has finished.
+	 *
+	 * task_scheduler is the thread pool implementation, and serial_executor runs everything on the
+	 * calling thread. shared_executor hands out persistent pools, so that threads are started once
+	 * per program instead of once per call.
+	 */
+	class executor {
+	public:
+		class task_group {
+		public:
+			task_group() : pending(0), failed(false) {}
+			bool done() const { return this->pending.load(std::memory_order_acquire) == 0; }
+
+		private:
+			friend class executor;
+			std::atomic<std::size_t> pending;
+			std::atomic<bool> failed;
+			std::exception_ptr error; //written once, by the task that set failed, before it finishes
+		};
+
+
+		virtual ~executor() {}
+
+
+		/**
+		 * The number of threads, including the calling thread, that execute tasks.
+		 */
+		virtual int concurrency() const = 0;
+
+
+		/**
+		 * Queues a task as part of the group. It may run on any thread, and it may already have run
+		 * when spawn returns.
+		 */
+		virtual void spawn(task_group& group, std::function<void()> task) = 0;
+
+
+		/**
+		 * Runs queued tasks until every task in the group has finished, and then rethrows the first
+		 * exception that a task of the group threw, if any did.
+		 */
+		virtual void wait(task_group& group) = 0;
+
+
+		/**
+		 * Calls body(x) for every x in [0, count) as separate tasks, and returns when all of them are
+		 * done. The calling thread runs body(0) itself. If any call throws, fork_join still waits for
+		 * the others, which refer to body, and then rethrows the first exception.
+		 */
+		void fork_join(std::size_t count, const std::function<void(std::size_t)>& body);
+
+
+		/**
+		 * The number of chunks that parallel_for splits count items into: one per thread, but none
+		 * with fewer than grain items, and at least one.
+		 */
+		std::size_t chunk_count(std::size_t count, std::size_t grain) const;
+
+
+		/**
+		 * Splits [0, count) into chunk_count(count, grain) contiguous chunks of about the same size and
+		 * calls body(chunk, begin, end) for each of them in parallel. The chunk numbers let the body
+		 * use per-chunk results, which the caller combines after parallel_for returns.
+		 */
+		void parallel_for(std::size_t count, std::size_t grain, const std::function<void(std::size_t, std::size_t, std::size_t)>& body);
+
+
+	protected:
+		static void add_task(task_group& group) {
+			group.pending.fetch_add(1, std::memory_order_relaxed);
+		}
+
+		static void finish_task(task_group& group) {
+			group.pending.fetch_sub(1, std::memory_order_release);
+		}
+
+		/**
+		 * Runs a task of the group, and keeps its exception for wait() if it throws.
+		 */
+		static void run_task(task_group& group, const std::function<void()>& task) {
+			try {
+				task();
+			} catch(...) {
+				if(!group.failed.exchange(true, std::memory_order_relaxed)){
+					group.error = std::current_exception();
+				}
+			}
+			finish_task(group);
+		}
+
+		static void rethrow(task_group& group) {
+			if(group.error){
+				std::rethrow_exception(group.error);
+			}
+		}
+	};
+
+
+	/**
+	 * Runs every task on the calling thread as soon as it is spawned.
+	 */
+	class serial_executor : public executor {
+	public:
+		int concurrency() const;
+		void spawn(task_group& group, std::function<void()> task);
+		void wait(task_group& group);
+	};
+
+
+	/**
+	 * A persistent executor with nthreads threads (including the calling thread), shared by every
+	 * caller that asks for the same number. nthreads below 2 gives a serial_executor. The pools live
+	 * until the program exits.
+	 */
+	std::shared_ptr<csce::executor> shared_executor(int nthreads);
+}
+
+#endif /* executor_hpp */
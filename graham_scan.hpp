@@ -4,15 +4,19 @@
 #include <vector>
 #include <string>
 #include <utility>
+#include <algorithm>
 
 #include "convex_hull_base.hpp"
 #include "point.hpp"
 #include "vector2d.hpp"
+#include "angular_sort.hpp"
 
 namespace csce {
 	template<typename T>
 	class graham_scan : public csce::convex_hull_base<T> {
 	public:
+		using csce::convex_hull_base<T>::compute_hull;
+		
 		graham_scan(int _nthreads) : csce::convex_hull_base<T>(_nthreads) {}
 		
 		
@@ -23,22 +27,20 @@ namespace csce {
 		
 		virtual std::vector<csce::point<T>> compute_hull(std::vector<csce::point<T>>& points) {
 			if(points.size() <= 3){
-				return points;
+				return this->small_hull(points);
 			}
 
+			csce::scratch_arena::scope scope(this->scratch());
 			std::size_t index = this->pivot_index(points);
 			if(index != 0){
 				std::swap(points[0], points[index]);
 			}
 			
 			//sort the points by angle around the pivot point (points[0])
-			std::sort(points.begin() + 1, points.end(), [&points](csce::point<T>& a, csce::point<T>& b) {
-				csce::vector2d<T> pa(points[0], a);
-				csce::vector2d<T> pb(points[0], b);
-				return pa.ccw(pb);
-			});
+			csce::serial_executor serial; //this is the sequential algorithm
+			csce::angular_sort<T>(points[0], serial, &this->scratch()).sort_array(points.begin() + 1, points.end());
 			
-			std::vector<csce::point<T>> s;
+			csce::scratch_vector<csce::point<T>> s(csce::arena_allocator<csce::point<T>>(&this->scratch()));
 			s.reserve(points.size() + 1);
 			
 			s.push_back(points[points.size() - 1]);
@@ -48,6 +50,10 @@ namespace csce {
 			int x=2;
 			while(x < points.size()){
 				std::size_t y = s.size() - 1;
+				if(y < 2){
+					s.push_back(points[x++]); //the pivot is a hull vertex, so it is never popped (all of the points can be collinear with it)
+					continue;
+				}
 				csce::vector2d<T> a(s[y-1], s[y]);
 				csce::vector2d<T> b(s[y-1], points[x]);
 				if(a.ccw(b)){
@@ -61,7 +67,7 @@ namespace csce {
 				s.pop_back(); //the polygon is closed, so remove the last element to remove the duplicate point
 			}
 
-			return s;
+			return std::vector<csce::point<T>>(s.begin(), s.end());
 		}
 		
 		
@@ -70,6 +76,36 @@ namespace csce {
 		
 	private:
 		
+		/**
+		 * The hull of at most three points, which are too few to scan: copies of a point are left out,
+		 * and so is the middle one of three collinear points. Three points that make a turn are returned
+		 * counterclockwise, like the scan returns them.
+		 */
+		std::vector<csce::point<T>> small_hull(const std::vector<csce::point<T>>& points) const {
+			std::vector<csce::point<T>> hull;
+			for(auto& point : points){
+				if(std::find(hull.begin(), hull.end(), point) == hull.end()){
+					hull.push_back(point);
+				}
+			}
+			if(hull.size() < 3){
+				return hull;
+			}
+
+			int turn = csce::orientation::turn(hull[0], hull[1], hull[2]);
+			if(turn < 0){
+				std::swap(hull[1], hull[2]);
+			} else if(turn == 0){
+				//the middle point is the one that is not an end of the longest of the three segments
+				auto a = csce::orientation::squared_distance(hull[1], hull[2]);
+				auto b = csce::orientation::squared_distance(hull[0], hull[2]);
+				auto c = csce::orientation::squared_distance(hull[0], hull[1]);
+				std::size_t middle = (a > b && a > c) ? 0 : ((b > c) ? 1 : 2);
+				hull.erase(hull.begin() + middle);
+			}
+			return hull;
+		}
+		
 		/**
 		 * Finds the index of the point with minimum y coordinate.
 		 * If there is a tie for minimum y coordinate, the index of the point with
@@ -80,12 +116,9 @@ namespace csce {
 			for(std::size_t x=0; x<points.size(); x++){
 				csce::point<T>& p0 = points[index];
 				csce::point<T>& cur = points[x];
-				if(csce::math_utility::less_than(cur.y, p0.y)){
+				//compared exactly, since angular_sort needs every other point to be level with or above the pivot
+				if(cur.y < p0.y || (cur.y == p0.y && cur.x < p0.x)){
 					index = x;
-				} else if(csce::math_utility::equals(cur.y, p0.y)){
-					if(csce::math_utility::less_than(cur.x, p0.x)){
-						index = x;
-					}
 				}
 			}
 			return index;
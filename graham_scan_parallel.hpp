@@ -4,6 +4,7 @@
 #include <vector>
 #include <string>
 #include <utility>
+#include <algorithm>
 #include <thread>
 #include <mutex>
 #include <functional>
@@ -13,12 +14,15 @@
 #include "vector2d.hpp"
 #include "sort.hpp"
 #include "sort_parallel.hpp"
+#include "angular_sort.hpp"
 #include "graham_scan.hpp"
 
 namespace csce {
 	template<typename T>
 	class graham_scan_parallel : public csce::convex_hull_base<T> {
 	public:
+		using csce::convex_hull_base<T>::compute_hull;
+		
 		graham_scan_parallel(int _nthreads) : csce::convex_hull_base<T>(_nthreads) {}
 		
 		
@@ -33,9 +37,12 @@ namespace csce {
 				//sequential version of this algorithm. It also handles some
 				//corner cases, such as sets of points that have three points or less.
 				csce::graham_scan<T> sequential(this->nthreads);
+				sequential.set_executor(this->pool);
+				sequential.set_arena(this->get_arena());
 				return sequential.compute_hull(points);
 			}
 	
+			csce::scratch_arena::scope scope(this->scratch());
 			std::size_t index = this->pivot_index(points);
 			if(index != 0){
 				std::swap(points.front(), points[index]);
@@ -44,7 +51,7 @@ namespace csce {
 			//csce::sort<T> sorter(points.front());
 			//sorter.sort_array(points.begin() + 1, points.end());
 		
-			csce::sort_parallel<T>(points.front(), this->nthreads).sort_array(points.begin() + 1, points.end());
+			csce::angular_sort<T>(points.front(), this->executor(), &this->scratch()).sort_array(points.begin() + 1, points.end());
 
 			//the points are now sorted by angle with respect to the south-most point (points[0])
 			//so divide the points into four different quadrants and process each quadrant in a
@@ -71,51 +78,66 @@ namespace csce {
 		std::size_t wpindex = 0;
 		std::mutex pivot_mutex;
 
+		//the quadrant hulls, kept between calls so that its memory is reused
+		std::vector<csce::point<T>> candidates;
+
 
-		void convex_hull_thread(const std::vector<csce::point<T>>& points, const std::size_t begin, const std::size_t end, std::vector<csce::point<T>>& output){
-			if(begin == end - 1){
-				output.push_back(points[begin]);
-				return;
+		/**
+		 * Runs Graham's scan over points [begin, end), anchored at the pivot (points[0]). The points
+		 * are sorted by angle around the pivot, which is a hull vertex, so the scan keeps every hull
+		 * vertex in the range no matter which points the neighbouring ranges hold. The pivot itself
+		 * is only output by the range that starts with it.
+		 */
+		void convex_hull_thread(const std::vector<csce::point<T>>& points, const std::size_t begin, const std::size_t end, csce::scratch_vector<csce::point<T>>& output){
+			if(begin >= end){
+				return; //two of the extreme points are the same point
+			}
+
+			output.reserve(end - begin + 1);
+			output.push_back(points[0]);
+			for(std::size_t x = std::max<std::size_t>(begin, 1); x < end; x++){
+				while(output.size() >= 2){
+					std::size_t y = output.size() - 1;
+					csce::vector2d<T> a(output[y-1], output[y]);
+					csce::vector2d<T> b(output[y-1], points[x]);
+					if(a.ccw(b)){
+						break;
+					}
+					output.pop_back();
+				}
+				output.push_back(points[x]);
 			}
 
-			output.push_back(begin == 0 ? points.back() : points[begin - 1]); //add the last point from the previous segment
-                        output.push_back(points[begin]);
-                        output.push_back(points[begin + 1]);
-
-                        std::size_t x = begin + 2;
-                        while(x < end){
-                                std::size_t y = output.size() - 1;
-                                csce::vector2d<T> a(output[y-1], output[y]);
-                                csce::vector2d<T> b(output[y-1], points[x]);
-                                if(a.ccw(b)){
-                                        output.push_back(points[x++]);
-                                } else {
-                                        output.pop_back();
-                                }
-                        }
+			if(begin != 0){
+				output.erase(output.begin());
+			}
 		}
 
 		std::vector<csce::point<T>> convex_hull(const std::vector<csce::point<T>>& points){
-			std::thread threads[4]; //there are four extreme points (N, E, S, W)
-			std::vector<std::vector<csce::point<T>>> convex_hulls(4);
-
-			threads[0] = std::thread(&csce::graham_scan_parallel<T>::convex_hull_thread, this, points, this->spindex, this->epindex, std::ref(convex_hulls[0]));
-			threads[1] = std::thread(&csce::graham_scan_parallel<T>::convex_hull_thread, this, points, this->epindex, this->npindex, std::ref(convex_hulls[1]));
-			threads[2] = std::thread(&csce::graham_scan_parallel<T>::convex_hull_thread, this, points, this->npindex, this->wpindex, std::ref(convex_hulls[2]));
-			threads[3] = std::thread(&csce::graham_scan_parallel<T>::convex_hull_thread, this, points, this->wpindex, points.size(), std::ref(convex_hulls[3]));
-
-			std::vector<csce::point<T>> output;
-                        for(int x=0; x<4; x++){
-                                threads[x].join();
+			//there are four extreme points (N, E, S, W)
+			//the pivot (S) is also the west point when no point is left of it, and then the west segment is empty
+			std::size_t west = this->wpindex == 0 ? points.size() : this->wpindex;
+			std::size_t bounds[5] = { this->spindex, this->epindex, this->npindex, west, points.size() };
+			csce::arena_allocator<csce::point<T>> allocator(&this->scratch());
+			csce::scratch_vector<csce::point<T>> convex_hulls[4] = { csce::scratch_vector<csce::point<T>>(allocator), csce::scratch_vector<csce::point<T>>(allocator), csce::scratch_vector<csce::point<T>>(allocator), csce::scratch_vector<csce::point<T>>(allocator) };
+			this->executor().fork_join(4, [&](std::size_t x) {
+				this->convex_hull_thread(points, bounds[x], bounds[x + 1], convex_hulls[x]);
+			});
+
+			std::vector<csce::point<T>>& output = this->candidates;
+			output.clear();
+			for(int x=0; x<4; x++){
 				for(auto& point : convex_hulls[x]){
 					output.push_back(point);
 				}
-                        }
+			}
 
 			//the output contains a mostly correct convex hull (which should be a lot smaller than the input array),
 			//so run the sequential algorithm to clean up an quadrant boundaries
 			csce::graham_scan<T> sequential(this->nthreads);
-                        return sequential.compute_hull(output);
+			sequential.set_executor(this->pool);
+			sequential.set_arena(this->get_arena());
+			return sequential.compute_hull(output);
 		}
 	
 		/**
@@ -124,21 +146,10 @@ namespace csce {
 		 * the minimum y coordinate and minimum x coordinate will be returned.
 		 */
 		std::size_t pivot_index(std::vector<csce::point<T>>& points) {
-			std::thread* threads = new std::thread[this->nthreads];
-			int nelements = static_cast<int>(std::ceil(static_cast<double>(points.size()) / static_cast<double>(this->nthreads)));
-			int start = 0, stop = nelements;
-			int segment_count = 0;
-			
-			for(int x=0; x<this->nthreads && start < points.size(); x++, start += nelements, stop += nelements){
-				threads[x] = std::thread(&csce::graham_scan_parallel<T>::pivot_index_thread, this, points, start, stop);
-				segment_count++;
-			}
-			
-			for(int x=0; x<segment_count; x++){
-				threads[x].join();
-			}
-			
-			delete[] threads;
+			this->spindex = this->npindex = this->epindex = this->wpindex = 0;
+			this->executor().parallel_for(points.size(), 1, [&](std::size_t, std::size_t start, std::size_t stop) {
+				this->pivot_index_thread(points, start, stop);
+			});
 			return this->spindex;
 		}
 		
@@ -162,47 +173,32 @@ namespace csce {
 			this->pivot_mutex.unlock();
 		}
 	
+		/**
+		 * Updates the extreme points with points[x]. The coordinates are compared exactly, without EPS,
+		 * since angular_sort needs every other point to be level with or above the south point.
+		 */
 		void get_pivot_points(const std::vector<csce::point<T>>& points, const std::size_t& x, std::size_t& n, std::size_t& e, std::size_t& s, std::size_t& w){
 			const csce::point<T>& ps = points[s];
-                        const csce::point<T>& pn = points[n];
-                        const csce::point<T>& pe = points[e];
-                        const csce::point<T>& pw = points[w];
-
-                        const csce::point<T>& cur = points[x];
-                        if(csce::math_utility::less_than(cur.y, ps.y)){
-                                s = x;
-                        } else if(csce::math_utility::equals(cur.y, ps.y)){
-                                if(csce::math_utility::less_than(cur.x, ps.x)){
-                                        s = x;
-                                }
-                        }
-                                
-
-                        if(csce::math_utility::less_than(pn.y, cur.y)){
-                                n = x;
-                        } else if(csce::math_utility::equals(cur.y, pn.y)){
-                                if(csce::math_utility::less_than(cur.x, pn.x)){
-                                        n = x;
-                                }
-                        }
-
-
-                        if(csce::math_utility::less_than(cur.x, pw.x)){
-                                w = x;
-                        } else if(csce::math_utility::equals(cur.x, pw.x)){
-                                if(csce::math_utility::less_than(cur.y, pw.y)){
-                                        w = x;
-                                }
-                        }
-
-
-                        if(csce::math_utility::less_than(pe.x, cur.x)){
-                                e = x;
-                        } else if(csce::math_utility::equals(cur.x, pe.x)){
-                                if(csce::math_utility::less_than(cur.y, pe.y)){
-                                        e = x;
-                                }
-                        }
+			const csce::point<T>& pn = points[n];
+			const csce::point<T>& pe = points[e];
+			const csce::point<T>& pw = points[w];
+
+			const csce::point<T>& cur = points[x];
+			if(cur.y < ps.y || (cur.y == ps.y && cur.x < ps.x)){
+				s = x;
+			}
+
+			if(pn.y < cur.y || (cur.y == pn.y && cur.x < pn.x)){
+				n = x;
+			}
+
+			if(cur.x < pw.x || (cur.x == pw.x && cur.y < pw.y)){
+				w = x;
+			}
+
+			if(pe.x < cur.x || (cur.x == pe.x && cur.y < pe.y)){
+				e = x;
+			}
 		}
 	};
 }
@@ -0,0 +1,144 @@
+#ifndef hull_merge_hpp
+#define hull_merge_hpp
+
+#include <vector>
+#include <utility>
+#include <algorithm>
+
+#include "point.hpp"
+#include "monotone_chain.hpp"
+
+namespace csce {
+	/**
+	 * A convex hull stored as its lower and upper chains. Both chains are in lexicographic
+	 * (x, then y) order and share their first and last points.
+	 */
+	template<typename T>
+	struct hull_chains {
+		std::vector<csce::point<T>> lower;
+		std::vector<csce::point<T>> upper;
+
+		bool empty() const {
+			return this->lower.empty();
+		}
+	};
+
+
+	namespace hull_merge {
+		/**
+		 * Builds the chains of the lexicographically sorted points in [begin, end).
+		 */
+		template<typename T, typename Iterator>
+		csce::hull_chains<T> from_sorted(Iterator begin, Iterator end) {
+			csce::hull_chains<T> chains;
+			chains.lower = csce::monotone_chain<T>::lower_chain(begin, end);
+			chains.upper = csce::monotone_chain<T>::upper_chain(begin, end);
+			return chains;
+		}
+
+
+		/**
+		 * Returns the hull as a counterclockwise polygon starting at the left-most point.
+		 */
+		template<typename T>
+		std::vector<csce::point<T>> to_polygon(const csce::hull_chains<T>& chains) {
+			return csce::monotone_chain<T>::join_chains(chains.lower, chains.upper);
+		}
+
+
+		/**
+		 * Finds the bridge between two chains, where every point of left comes before every point
+		 * of right in lexicographic order. side is 1 for upper chains and -1 for lower chains.
+		 * Returns the index in left and the index in right of the bridge end points.
+		 *
+		 * For a fixed left point, the tangent point on the right chain is found with a binary search.
+		 * That tangent tells whether the bridge starts before or after the left point, so an outer
+		 * binary search over the left chain finds the bridge in O(log(h)^2) orientation tests.
+		 */
+		template<typename T>
+		std::pair<std::size_t, std::size_t> bridge(const std::vector<csce::point<T>>& left, const std::vector<csce::point<T>>& right, int side) {
+			auto tangent = [&](const csce::point<T>& p) {
+				//skip right points as long as the next one is on the outer side of (or collinear with) p->right[j]
+				std::size_t lo = 0, hi = right.size() - 1;
+				while(lo < hi){
+					std::size_t mid = (lo + hi) / 2;
+					if(side * csce::monotone_chain<T>::cross(p, right[mid], right[mid + 1]) >= 0){
+						lo = mid + 1;
+					} else {
+						hi = mid;
+					}
+				}
+				return lo;
+			};
+
+			//skip left points as long as the next one is strictly on the outer side of the tangent line
+			std::size_t lo = 0, hi = left.size() - 1;
+			while(lo < hi){
+				std::size_t mid = (lo + hi) / 2;
+				std::size_t j = tangent(left[mid]);
+				if(side * csce::monotone_chain<T>::cross(left[mid], right[j], left[mid + 1]) > 0){
+					lo = mid + 1;
+				} else {
+					hi = mid;
+				}
+			}
+			return std::make_pair(lo, tangent(left[lo]));
+		}
+
+
+		/**
+		 * Combines two hulls that may overlap. Every vertex of the combined lower chain is a vertex
+		 * of one of the two lower chains (and the same for the upper chains), so the chains are
+		 * merged in lexicographic order and rebuilt in O(h) time.
+		 */
+		template<typename T>
+		csce::hull_chains<T> combine(const csce::hull_chains<T>& a, const csce::hull_chains<T>& b) {
+			if(a.empty()){
+				return b;
+			}
+			if(b.empty()){
+				return a;
+			}
+
+			std::vector<csce::point<T>> points(a.lower.size() + b.lower.size());
+			std::merge(a.lower.begin(), a.lower.end(), b.lower.begin(), b.lower.end(), points.begin(), csce::monotone_chain<T>::lexicographic_less);
+
+			csce::hull_chains<T> combined;
+			combined.lower = csce::monotone_chain<T>::lower_chain(points.begin(), points.end());
+
+			points.resize(a.upper.size() + b.upper.size());
+			std::merge(a.upper.begin(), a.upper.end(), b.upper.begin(), b.upper.end(), points.begin(), csce::monotone_chain<T>::lexicographic_less);
+			combined.upper = csce::monotone_chain<T>::upper_chain(points.begin(), points.end());
+			return combined;
+		}
+
+
+		/**
+		 * Merges two hulls that are separated in lexicographic order (every point of left comes
+		 * before every point of right) by joining each pair of chains at its bridge.
+		 */
+		template<typename T>
+		csce::hull_chains<T> merge(const csce::hull_chains<T>& left, const csce::hull_chains<T>& right) {
+			if(left.empty()){
+				return right;
+			}
+			if(right.empty()){
+				return left;
+			}
+
+			csce::hull_chains<T> merged;
+			std::pair<std::size_t, std::size_t> lower = csce::hull_merge::bridge(left.lower, right.lower, -1);
+			merged.lower.reserve(lower.first + 1 + right.lower.size() - lower.second);
+			merged.lower.insert(merged.lower.end(), left.lower.begin(), left.lower.begin() + lower.first + 1);
+			merged.lower.insert(merged.lower.end(), right.lower.begin() + lower.second, right.lower.end());
+
+			std::pair<std::size_t, std::size_t> upper = csce::hull_merge::bridge(left.upper, right.upper, 1);
+			merged.upper.reserve(upper.first + 1 + right.upper.size() - upper.second);
+			merged.upper.insert(merged.upper.end(), left.upper.begin(), left.upper.begin() + upper.first + 1);
+			merged.upper.insert(merged.upper.end(), right.upper.begin() + upper.second, right.upper.end());
+			return merged;
+		}
+	}
+}
+
+#endif /* hull_merge_hpp */
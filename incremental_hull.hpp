@@ -0,0 +1,234 @@
+#ifndef incremental_hull_hpp
+#define incremental_hull_hpp
+
+#include <vector>
+#include <set>
+#include <iterator>
+
+#include "point.hpp"
+#include "monotone_chain.hpp"
+
+namespace csce {
+	/**
+	 * A convex hull that is kept up to date as points are inserted, so that adding a few points
+	 * to a large set does not need a full recompute. The lower and upper chains are stored in
+	 * balanced search trees ordered lexicographically, and hold exactly the points that
+	 * monotone_chain would put on them.
+	 *
+	 * Inserting a point inside the hull is a single O(log h) lookup. A point outside the hull is
+	 * inserted next to its lexicographic neighbours, and the chain points that stop being convex
+	 * are erased; every point is erased at most once, so insertion is O(log h) amortized.
+	 */
+	template<typename T>
+	class incremental_hull {
+	public:
+		struct lexicographic_order {
+			bool operator()(const csce::point<T>& a, const csce::point<T>& b) const {
+				return csce::monotone_chain<T>::lexicographic_less(a, b);
+			}
+		};
+
+		typedef std::set<csce::point<T>, lexicographic_order> chain_type;
+
+
+		/**
+		 * What an insertion changed: whether the point went on each chain, and the chain points that
+		 * it erased. It is enough to undo the insertion.
+		 */
+		struct change {
+			csce::point<T> p;
+			bool lower_inserted = false;
+			bool upper_inserted = false;
+			std::vector<csce::point<T>> lower_erased;
+			std::vector<csce::point<T>> upper_erased;
+		};
+
+
+		incremental_hull() {}
+
+
+		template<typename Iterator>
+		incremental_hull(Iterator begin, Iterator end) {
+			this->insert(begin, end);
+		}
+
+
+		/**
+		 * Adds a point. Returns true if the hull changed.
+		 */
+		bool insert(const csce::point<T>& p) {
+			bool lower_changed = this->insert(this->lower_points, p, -1, nullptr);
+			bool upper_changed = this->insert(this->upper_points, p, 1, nullptr);
+			return lower_changed || upper_changed;
+		}
+
+
+		/**
+		 * Adds a point and records what changed in record, so that undo can take it out again.
+		 */
+		bool insert(const csce::point<T>& p, change& record) {
+			record.p = p;
+			record.lower_inserted = this->insert(this->lower_points, p, -1, &record.lower_erased);
+			record.upper_inserted = this->insert(this->upper_points, p, 1, &record.upper_erased);
+			return record.lower_inserted || record.upper_inserted;
+		}
+
+
+		/**
+		 * Takes out the insertion that record describes, which must be the last one that has not been
+		 * undone yet, so that insertions are undone in the opposite order. Costs O(k log h) for the k
+		 * points that the insertion erased.
+		 */
+		void undo(const change& record) {
+			if(record.lower_inserted){
+				this->lower_points.erase(record.p);
+			}
+			if(record.upper_inserted){
+				this->upper_points.erase(record.p);
+			}
+			this->lower_points.insert(record.lower_erased.begin(), record.lower_erased.end());
+			this->upper_points.insert(record.upper_erased.begin(), record.upper_erased.end());
+		}
+
+
+		/**
+		 * Adds the points in [begin, end). Returns how many of them changed the hull.
+		 */
+		template<typename Iterator>
+		std::size_t insert(Iterator begin, Iterator end) {
+			std::size_t changes = 0;
+			for(Iterator it = begin; it != end; it++){
+				if(this->insert(*it)){
+					changes++;
+				}
+			}
+			return changes;
+		}
+
+
+		/**
+		 * Returns true if p is inside or on the boundary of the hull.
+		 */
+		bool contains(const csce::point<T>& p) const {
+			return !this->empty() && !this->outside(this->lower_points, p, -1) && !this->outside(this->upper_points, p, 1);
+		}
+
+
+		/**
+		 * Returns the hull as a counterclockwise polygon starting at the left-most point,
+		 * the same polygon monotone_chain returns for all of the inserted points.
+		 */
+		std::vector<csce::point<T>> hull() const {
+			std::vector<csce::point<T>> lower(this->lower_points.begin(), this->lower_points.end());
+			std::vector<csce::point<T>> upper(this->upper_points.begin(), this->upper_points.end());
+			return csce::monotone_chain<T>::join_chains(lower, upper);
+		}
+
+
+		/**
+		 * The chains, in lexicographic order. Both start at the left-most point and end at the right-most point.
+		 */
+		const chain_type& lower() const {
+			return this->lower_points;
+		}
+
+
+		const chain_type& upper() const {
+			return this->upper_points;
+		}
+
+
+		/**
+		 * The number of hull vertices.
+		 */
+		std::size_t size() const {
+			if(this->lower_points.size() <= 1){
+				return this->lower_points.size();
+			}
+			return this->lower_points.size() + this->upper_points.size() - 2;
+		}
+
+
+		bool empty() const {
+			return this->lower_points.empty();
+		}
+
+
+		void clear() {
+			this->lower_points.clear();
+			this->upper_points.clear();
+		}
+
+
+	private:
+		chain_type lower_points;
+		chain_type upper_points;
+
+
+		/**
+		 * Returns true if p is strictly outside of the chain, where side is 1 for the upper chain and -1 for the lower chain.
+		 */
+		bool outside(const chain_type& chain, const csce::point<T>& p, int side) const {
+			if(chain.empty()){
+				return true;
+			}
+
+			typename chain_type::const_iterator next = chain.lower_bound(p);
+			if(next == chain.end() || next == chain.begin()){
+				//past one of the end points, unless it is the left-most point itself
+				return next == chain.end() || *next != p;
+			}
+			if(*next == p){
+				return false;
+			}
+			typename chain_type::const_iterator previous = std::prev(next);
+			return side * csce::monotone_chain<T>::cross(*previous, *next, p) > 0;
+		}
+
+
+		/**
+		 * Inserts p into the chain if it is outside of it and erases the points that are no longer convex,
+		 * which are added to erased unless it is null. Returns true if the chain changed.
+		 */
+		bool insert(chain_type& chain, const csce::point<T>& p, int side, std::vector<csce::point<T>>* erased) {
+			if(!this->outside(chain, p, side)){
+				return false;
+			}
+
+			typename chain_type::iterator current = chain.insert(p).first;
+
+			//erase points after p that are no longer convex, including collinear ones
+			while(true){
+				typename chain_type::iterator next = std::next(current);
+				if(next == chain.end() || std::next(next) == chain.end()){
+					break;
+				}
+				if(side * csce::monotone_chain<T>::cross(p, *next, *std::next(next)) < 0){
+					break;
+				}
+				if(erased != nullptr){
+					erased->push_back(*next);
+				}
+				chain.erase(next);
+			}
+
+			//and the same for the points before p
+			while(current != chain.begin()){
+				typename chain_type::iterator previous = std::prev(current);
+				if(previous == chain.begin()){
+					break;
+				}
+				if(side * csce::monotone_chain<T>::cross(*std::prev(previous), *previous, p) < 0){
+					break;
+				}
+				if(erased != nullptr){
+					erased->push_back(*previous);
+				}
+				chain.erase(previous);
+			}
+			return true;
+		}
+	};
+}
+
+#endif /* incremental_hull_hpp */
@@ -7,12 +7,14 @@
 
 #include "convex_hull_base.hpp"
 #include "point.hpp"
-#include "vector2d.hpp"
+#include "orientation_kernels.hpp"
 
 namespace csce {
 	template<typename T>
 	class jarvis_march : public csce::convex_hull_base<T> {
 	public:
+		using csce::convex_hull_base<T>::compute_hull;
+		
 		jarvis_march(int _nthreads) : convex_hull_base<T>(_nthreads){}
 		
 		
@@ -26,52 +28,69 @@ namespace csce {
 		}
 		
 		
+		/**
+		 * The march only reads the points, so it walks the span itself.
+		 */
+		virtual std::vector<csce::point<T>> compute_hull(const csce::point_span<T>& points) {
+			return this->performShortestPathCalculation(points);
+		}
+		
+		
 		~jarvis_march() {}
 		
 		
 	private:
-		std::vector<csce::point<T>> performShortestPathCalculation(const std::vector<csce::point<T>>& points) const {
+		std::vector<csce::point<T>> performShortestPathCalculation(const csce::point_span<T>& points) const {
 			std::vector<csce::point<T>> resultsOfShortestPath;
-			int topMostPoint = 0;
-			for(int i = 0; i < points.size(); i++){
-				if(points[i].y > points[topMostPoint].y){
+			std::size_t topMostPoint = 0;
+			for(std::size_t i = 0; i < points.size(); i++){
+				//the rightmost of the top-most points, so that it is a corner of the hull
+				if(points[i].y > points[topMostPoint].y || (points[i].y == points[topMostPoint].y && points[i].x > points[topMostPoint].x)){
 					topMostPoint = i;
 				}
 			}
 			
-			int tempPoint1 = topMostPoint;
-			int tempPoint2 = 0;
-			int orientationValue = 0;
+			std::size_t tempPoint1 = topMostPoint;
+			std::size_t tempPoint2 = 0;
 			do{
-				tempPoint2 = (tempPoint1 + 1) % points.size();
-				for(int i = 0; i < points.size(); i++){
-					orientationValue = operation(points[tempPoint1],points[i],points[tempPoint2]);
-					if(orientationValue == 2){
+				tempPoint2 = this->other_point(points, tempPoint1);
+				if(tempPoint2 == tempPoint1){
+					resultsOfShortestPath.push_back(points[tempPoint1]); //every point is the same
+					break;
+				}
+				//every point left of tempPoint1->tempPoint2 becomes the new candidate, so jump from one to the next
+				for(std::size_t i = csce::orientation_kernels::find(points.data(), points.size(), points[tempPoint1], points[tempPoint2], 1); i < points.size(); ){
+					tempPoint2 = i;
+					i += 1 + csce::orientation_kernels::find(points.data() + i + 1, points.size() - i - 1, points[tempPoint1], points[tempPoint2], 1);
+				}
+				//points further along the same line are on the hull edge, and the last of them is the next corner
+				for(std::size_t i = csce::orientation_kernels::find(points.data(), points.size(), points[tempPoint1], points[tempPoint2], 0); i < points.size(); ){
+					if(csce::orientation::dot(points[tempPoint1], points[tempPoint2], points[i]) > csce::orientation::dot(points[tempPoint1], points[tempPoint2], points[tempPoint2])){
 						tempPoint2 = i;
 					}
+					i += 1 + csce::orientation_kernels::find(points.data() + i + 1, points.size() - i - 1, points[tempPoint1], points[tempPoint2], 0);
 				}
 				resultsOfShortestPath.push_back(points[tempPoint2]);
 				tempPoint1 = tempPoint2;
 			}
-			while(tempPoint1 != topMostPoint);
+			while(points[tempPoint1] != points[topMostPoint]);
 			
 			return resultsOfShortestPath;
 		}
 		
 		
-		int operation(csce::point<T> d, csce::point<T> e, csce::point<T> f) const {
-			csce::vector2d<T> a(e,d);
-			csce::vector2d<T> b(e,f);
-			bool is_counterclockwise = a.ccw(b);
-			if(is_counterclockwise == true){
-				return 2;
-			}
-			else {
-				return 0;
+		/**
+		 * The index of the first point after x that is not a copy of points[x], or x if there is none.
+		 */
+		std::size_t other_point(const csce::point_span<T>& points, std::size_t x) const {
+			for(std::size_t i = 1; i < points.size(); i++){
+				std::size_t y = (x + i) % points.size();
+				if(points[y] != points[x]){
+					return y;
+				}
 			}
+			return x;
 		}
-		
-		
 	};
 }
 
@@ -4,16 +4,17 @@
 #include <vector>
 #include <string>
 #include <utility>
-#include <omp.h>
 
 #include "convex_hull_base.hpp"
 #include "point.hpp"
-#include "vector2d.hpp"
+#include "orientation.hpp"
 
 namespace csce {
 	template<typename T>
 	class jarvis_march_parallel : public csce::convex_hull_base<T> {
 	public:
+		using csce::convex_hull_base<T>::compute_hull;
+		
 		jarvis_march_parallel(int _nthreads) : convex_hull_base<T>(_nthreads){}
 		
 		
@@ -27,76 +28,81 @@ namespace csce {
 		}
 		
 		
+		/**
+		 * The march only reads the points, so it walks the span itself.
+		 */
+		std::vector<csce::point<T>> compute_hull(const csce::point_span<T>& points) {
+			return this->performShortestPathCalculation(points);
+		}
+		
+		
 		~jarvis_march_parallel() {}
 		
 		
 	private:
-		std::vector<csce::point<T>> performShortestPathCalculation(const std::vector<csce::point<T>>& points) const {
+		std::vector<csce::point<T>> performShortestPathCalculation(const csce::point_span<T>& points) const {
 			std::vector<csce::point<T>> resultsOfShortestPath;
-			int topMostPoint = 0;
-			int leftMostPoint = 0;
-			int rightMostPoint = 0;
-			int bottomMostPoint = 0;
-			int topLeft = 0;
-			int topRight = 0;
-			int bottomLeft = 0;
-			int bottomRight = 0;
-			#pragma omp parallel for num_threads(this->nthreads) 
-			for(int i = 0; i < points.size(); i++){
-				if(points[i].y > points[topMostPoint].y){
-					topMostPoint = i;
-				}
-				if(points[i].y < points[bottomMostPoint].y) {
-					bottomMostPoint = i;
-				}
-				if(points[i].x > points[rightMostPoint].x) { 
-					rightMostPoint = i;
-				}
-				if(points[i].x < points[leftMostPoint].x) {
-					leftMostPoint = i;
-				}
-			}
-			#pragma omp parallel for num_threads(this->nthreads)
-			for(int i = 0; i < points.size(); i++) {
-				if(points[i] == points[topMostPoint] + points[leftMostPoint]){
-					topLeft = i;
-				}
-				if(points[i] == points[topMostPoint] + points[rightMostPoint]) {
-					topRight = i;
+			csce::executor& pool = this->executor();
+			std::vector<std::size_t> candidates(pool.chunk_count(points.size(), minimum_chunk));
+			
+			// every chunk finds its own top-most point, and the chunks' points are compared after
+			pool.parallel_for(points.size(), minimum_chunk, [&](std::size_t chunk, std::size_t begin, std::size_t end) {
+				std::size_t topMostPoint = begin;
+				for(std::size_t i = begin; i < end; i++){
+					if(points[i].y > points[topMostPoint].y || (points[i].y == points[topMostPoint].y && points[i].x > points[topMostPoint].x)){
+						topMostPoint = i;
+					}
 				}
-				if(points[i] == points[bottomMostPoint] + points[leftMostPoint]) {
-					bottomLeft = i;
+				candidates[chunk] = topMostPoint;
+			});
+			std::size_t topMostPoint = candidates[0];
+			for(std::size_t i : candidates){
+				if(points[i].y > points[topMostPoint].y || (points[i].y == points[topMostPoint].y && points[i].x > points[topMostPoint].x)){
+					topMostPoint = i;
 				}
-				if(points[i] == points[bottomMostPoint] + points[rightMostPoint]) {
-					bottomRight = i;
-				} 
 			}
-			int tempPoint1 = topMostPoint;
-			int tempPoint2 = 0;
-			int orientationValue = 0;
+			
+			std::size_t tempPoint1 = topMostPoint;
+			std::size_t tempPoint2 = 0;
 			do{
 				tempPoint2 = (tempPoint1 + 1) % points.size();
-				#pragma omp parallel for num_threads(this->nthreads)
-				for(int i = 0; i < points.size(); i++){
-					orientationValue = operation(points[tempPoint1],points[i],points[tempPoint2]);
-					if(orientationValue == 2){
+				while(points[tempPoint2] == points[tempPoint1] && tempPoint2 != topMostPoint){
+					tempPoint2 = (tempPoint2 + 1) % points.size(); //a copy of tempPoint1 does not give a direction
+				}
+				if(points[tempPoint2] == points[tempPoint1]){
+					resultsOfShortestPath.push_back(points[tempPoint1]); //every point is the same
+					break;
+				}
+				pool.parallel_for(points.size(), minimum_chunk, [&](std::size_t chunk, std::size_t begin, std::size_t end) {
+					std::size_t candidate = tempPoint2;
+					for(std::size_t i = begin; i < end; i++){
+						if(operation(points[tempPoint1], points[i], points[candidate]) == 2){
+							candidate = i;
+						}
+					}
+					candidates[chunk] = candidate;
+				});
+				for(std::size_t i : candidates){
+					if(operation(points[tempPoint1], points[i], points[tempPoint2]) == 2){
 						tempPoint2 = i;
 					}
 				}
 				
 				resultsOfShortestPath.push_back(points[tempPoint2]);
 				tempPoint1 = tempPoint2;
-			}while(tempPoint1 != topMostPoint);
+			}while(points[tempPoint1] != points[topMostPoint]);
 
 			return resultsOfShortestPath;
 		}
 		
 		
-		int operation(csce::point<T> d, csce::point<T> e, csce::point<T> f) const {
-			csce::vector2d<T> a(e,d);
-			csce::vector2d<T> b(e,f);
-			bool is_counterclockwise = a.ccw(b);
-			if(is_counterclockwise == true){
+		/**
+		 * Returns 2 if e should replace f as the next point after d: if it is left of d->f, or further
+		 * along the same line.
+		 */
+		int operation(const csce::point<T>& d, const csce::point<T>& e, const csce::point<T>& f) const {
+			int turn = csce::orientation::turn(d, f, e);
+			if(turn > 0 || (turn == 0 && csce::orientation::dot(d, f, e) > csce::orientation::dot(d, f, f))){
 				return 2;
 			}
 			else {
@@ -105,6 +111,8 @@ namespace csce {
 		}
 		
 		
+		//smaller chunks are not worth a task
+		static const std::size_t minimum_chunk = 4096;
 	};
 }
 
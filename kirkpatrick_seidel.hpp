@@ -0,0 +1,348 @@
+#ifndef kirkpatrick_seidel_hpp
+#define kirkpatrick_seidel_hpp
+
+#include <vector>
+#include <string>
+#include <algorithm>
+
+#include "convex_hull_base.hpp"
+#include "point.hpp"
+#include "monotone_chain.hpp"
+
+namespace csce {
+	/**
+	 * Kirkpatrick-Seidel's "marriage before conquest" algorithm. Instead of sorting, every
+	 * recursion step finds the bridge over the median x coordinate by prune and search (half
+	 * of the slope pairs can be thrown away in every round), then recurses on the points that
+	 * are still outside of the bridge. This runs in O(n log h) time.
+	 *
+	 * Slopes are never divided out: they are compared with cross multiplication, so integer
+	 * coordinates stay exact. The pairing, maximum and pruning passes are split over the executor.
+	 */
+	template<typename T>
+	class kirkpatrick_seidel : public csce::convex_hull_base<T> {
+	public:
+		using csce::convex_hull_base<T>::compute_hull;
+		
+		kirkpatrick_seidel(int _nthreads) : csce::convex_hull_base<T>(_nthreads) {}
+
+
+		std::string name() const {
+			return "Kirkpatrick-Seidel";
+		}
+
+
+		virtual std::vector<csce::point<T>> compute_hull(std::vector<csce::point<T>>& points) {
+			if(points.size() <= 3){
+				return points;
+			}
+
+			//the chains have the same end points as the monotone chain ones, so they can be joined the same way
+			std::vector<csce::point<T>> lower = this->chain(points, -1);
+			std::vector<csce::point<T>> upper = this->chain(points, 1);
+			return csce::monotone_chain<T>::join_chains(lower, upper);
+		}
+
+
+		~kirkpatrick_seidel() {}
+
+
+	private:
+		//passes over fewer points than this are not split across threads
+		static const std::size_t parallel_cutoff = 1 << 14;
+
+		//the parallel_for grain that keeps a pass of count items on one chunk below the cutoff
+		static std::size_t grain(std::size_t count) {
+			return count >= parallel_cutoff ? 1 : count;
+		}
+
+		//slopes are compared by multiplying coordinate differences, so integer coordinates are widened first
+		typedef typename csce::orientation::wide<T>::type wide_type;
+
+		struct pair {
+			csce::point<T> p;
+			csce::point<T> q;
+			wide_type dx;
+			wide_type dy;
+		};
+
+
+		/**
+		 * The height of a point, flipped for the lower chain so that both chains are computed as upper chains.
+		 */
+		T height(const csce::point<T>& p, int side) const {
+			return side > 0 ? p.y : -p.y;
+		}
+
+
+		/**
+		 * Returns the chain in lexicographic order, from the lexicographically smallest point to the largest point.
+		 * side is 1 for the upper chain and -1 for the lower chain.
+		 */
+		std::vector<csce::point<T>> chain(const std::vector<csce::point<T>>& points, int side) {
+			//the end points of the chain are the highest left-most and right-most points
+			csce::point<T> first = points[0];
+			csce::point<T> last = points[0];
+			csce::point<T> smallest = points[0];
+			csce::point<T> largest = points[0];
+			for(auto& p : points){
+				if(p.x < first.x || (p.x == first.x && this->height(p, side) > this->height(first, side))){
+					first = p;
+				}
+				if(p.x > last.x || (p.x == last.x && this->height(p, side) > this->height(last, side))){
+					last = p;
+				}
+				if(csce::monotone_chain<T>::lexicographic_less(p, smallest)){
+					smallest = p;
+				}
+				if(csce::monotone_chain<T>::lexicographic_less(largest, p)){
+					largest = p;
+				}
+			}
+
+			std::vector<csce::point<T>> output;
+			if(smallest != first){
+				output.push_back(smallest); //vertical edge on the left side
+			}
+			output.push_back(first);
+
+			if(first.x != last.x){
+				std::vector<csce::point<T>> outside = this->collect(points, [&](const csce::point<T>& p) {
+					return this->above(first, last, p, side);
+				});
+				this->connect(first, last, outside, side, output);
+				output.push_back(last);
+			}
+
+			if(largest != output.back()){
+				output.push_back(largest); //vertical edge on the right side
+			}
+			return output;
+		}
+
+
+		/**
+		 * Appends the chain vertices strictly between k and m. Every point in candidates is strictly above k->m.
+		 */
+		void connect(const csce::point<T>& k, const csce::point<T>& m, std::vector<csce::point<T>>& candidates, int side, std::vector<csce::point<T>>& output) {
+			if(candidates.empty()){
+				return;
+			}
+
+			candidates.push_back(k);
+			candidates.push_back(m);
+
+			//the lower median x is always smaller than m.x, since m is the only point with that x
+			std::size_t middle = (candidates.size() - 1) / 2;
+			std::nth_element(candidates.begin(), candidates.begin() + middle, candidates.end(), [](const csce::point<T>& a, const csce::point<T>& b) { return a.x < b.x; });
+			T a = candidates[middle].x;
+
+			csce::point<T> left, right;
+			this->bridge(candidates, a, side, left, right);
+
+			if(left != k){
+				std::vector<csce::point<T>> outside = this->collect(candidates, [&](const csce::point<T>& p) {
+					return p.x < left.x && this->above(k, left, p, side);
+				});
+				this->connect(k, left, outside, side, output);
+				output.push_back(left);
+			}
+
+			if(right != m){
+				std::vector<csce::point<T>> outside = this->collect(candidates, [&](const csce::point<T>& p) {
+					return p.x > right.x && this->above(right, m, p, side);
+				});
+				output.push_back(right);
+				this->connect(right, m, outside, side, output);
+			}
+		}
+
+
+		/**
+		 * Finds the bridge over the vertical line x = a by prune and search.
+		 */
+		void bridge(std::vector<csce::point<T>> points, T a, int side, csce::point<T>& left, csce::point<T>& right) {
+			std::vector<pair> pairs;
+			std::vector<csce::point<T>> candidates;
+
+			while(true){
+				if(points.size() == 2){
+					bool ordered = points[0].x < points[1].x;
+					left = ordered ? points[0] : points[1];
+					right = ordered ? points[1] : points[0];
+					return;
+				}
+
+				//pair up the points. Of two points on the same vertical line only the higher one can be on the bridge.
+				std::size_t npairs = points.size() / 2;
+				pairs.resize(npairs);
+				std::vector<char> vertical(npairs, 0);
+				this->executor().parallel_for(npairs, grain(npairs), [&](std::size_t, std::size_t begin, std::size_t end) {
+					for(std::size_t x=begin; x<end; x++){
+						const csce::point<T>& u = points[2 * x];
+						const csce::point<T>& v = points[2 * x + 1];
+						pair& current = pairs[x];
+						current.p = u.x < v.x ? u : v;
+						current.q = u.x < v.x ? v : u;
+						current.dx = static_cast<wide_type>(current.q.x - current.p.x);
+						current.dy = static_cast<wide_type>(this->height(current.q, side) - this->height(current.p, side));
+						vertical[x] = current.dx == 0;
+					}
+				});
+
+				candidates.clear();
+				if(points.size() % 2 == 1){
+					candidates.push_back(points.back());
+				}
+				std::size_t sloped = 0;
+				for(std::size_t x=0; x<npairs; x++){
+					if(vertical[x]){
+						candidates.push_back(this->height(pairs[x].p, side) > this->height(pairs[x].q, side) ? pairs[x].p : pairs[x].q);
+					} else {
+						pairs[sloped++] = pairs[x];
+					}
+				}
+				pairs.resize(sloped);
+
+				if(pairs.empty()){
+					points.swap(candidates);
+					continue;
+				}
+
+				//the median slope (dx is always positive, so slopes compare by cross multiplication)
+				std::size_t middle = pairs.size() / 2;
+				std::nth_element(pairs.begin(), pairs.begin() + middle, pairs.end(), [](const pair& u, const pair& v) { return u.dy * v.dx < v.dy * u.dx; });
+				wide_type kdx = pairs[middle].dx;
+				wide_type kdy = pairs[middle].dy;
+
+				//the points that maximize height - slope * x are touched by the supporting line with the median slope
+				csce::point<T> min_touch, max_touch;
+				this->supporting_points(points, kdx, kdy, side, min_touch, max_touch);
+
+				if(min_touch.x <= a && max_touch.x > a){
+					left = min_touch;
+					right = max_touch;
+					return;
+				}
+
+				bool bridge_is_right = max_touch.x <= a;
+				std::vector<std::vector<csce::point<T>>> kept(this->executor().chunk_count(pairs.size(), grain(pairs.size())));
+				this->executor().parallel_for(pairs.size(), grain(pairs.size()), [&](std::size_t chunk, std::size_t begin, std::size_t end) {
+					std::vector<csce::point<T>>& local = kept[chunk];
+					for(std::size_t x=begin; x<end; x++){
+						const pair& current = pairs[x];
+						wide_type lhs = current.dy * kdx;
+						wide_type rhs = kdy * current.dx;
+						if(bridge_is_right){
+							//a pair steeper than (or as steep as) the median keeps its right point only
+							if(lhs >= rhs){
+								local.push_back(current.q);
+							} else {
+								local.push_back(current.p);
+								local.push_back(current.q);
+							}
+						} else {
+							//a pair flatter than (or as flat as) the median keeps its left point only
+							if(lhs <= rhs){
+								local.push_back(current.p);
+							} else {
+								local.push_back(current.p);
+								local.push_back(current.q);
+							}
+						}
+					}
+				});
+				for(auto& local : kept){
+					candidates.insert(candidates.end(), local.begin(), local.end());
+				}
+				points.swap(candidates);
+			}
+		}
+
+
+		/**
+		 * Finds the left-most and right-most of the points that maximize height - (kdy / kdx) * x.
+		 */
+		void supporting_points(const std::vector<csce::point<T>>& points, wide_type kdx, wide_type kdy, int side, csce::point<T>& min_touch, csce::point<T>& max_touch) {
+			//compares the intercepts of u and w: positive if u is higher
+			auto compare = [&](const csce::point<T>& u, const csce::point<T>& w) {
+				return static_cast<wide_type>(this->height(u, side) - this->height(w, side)) * kdx - kdy * static_cast<wide_type>(u.x - w.x);
+			};
+
+			std::size_t chunks = this->executor().chunk_count(points.size(), grain(points.size()));
+			std::vector<csce::point<T>> min_touches(chunks, points[0]);
+			std::vector<csce::point<T>> max_touches(chunks, points[0]);
+
+			this->executor().parallel_for(points.size(), grain(points.size()), [&](std::size_t chunk, std::size_t begin, std::size_t end) {
+				csce::point<T> lo = points[0];
+				csce::point<T> hi = points[0];
+				for(std::size_t x=begin; x<end; x++){
+					const csce::point<T>& p = points[x];
+					wide_type difference = compare(p, lo);
+					if(difference > 0){
+						lo = p;
+						hi = p;
+					} else if(difference == 0){
+						if(p.x < lo.x){
+							lo = p;
+						}
+						if(p.x > hi.x){
+							hi = p;
+						}
+					}
+				}
+				min_touches[chunk] = lo;
+				max_touches[chunk] = hi;
+			});
+
+			min_touch = min_touches[0];
+			max_touch = max_touches[0];
+			for(std::size_t x=1; x<chunks; x++){
+				wide_type difference = compare(min_touches[x], min_touch);
+				if(difference > 0){
+					min_touch = min_touches[x];
+					max_touch = max_touches[x];
+				} else if(difference == 0){
+					if(min_touches[x].x < min_touch.x){
+						min_touch = min_touches[x];
+					}
+					if(max_touches[x].x > max_touch.x){
+						max_touch = max_touches[x];
+					}
+				}
+			}
+		}
+
+
+		/**
+		 * Returns the points that satisfy the predicate, keeping their order.
+		 */
+		template<typename Predicate>
+		std::vector<csce::point<T>> collect(const std::vector<csce::point<T>>& points, Predicate keep) const {
+			std::vector<std::vector<csce::point<T>>> kept(this->executor().chunk_count(points.size(), grain(points.size())));
+			this->executor().parallel_for(points.size(), grain(points.size()), [&](std::size_t chunk, std::size_t begin, std::size_t end) {
+				for(std::size_t x=begin; x<end; x++){
+					if(keep(points[x])){
+						kept[chunk].push_back(points[x]);
+					}
+				}
+			});
+
+			std::vector<csce::point<T>> output;
+			for(auto& local : kept){
+				output.insert(output.end(), local.begin(), local.end());
+			}
+			return output;
+		}
+
+
+		/**
+		 * Returns true if p is strictly above the line from a to b (a is left of b).
+		 */
+		bool above(const csce::point<T>& a, const csce::point<T>& b, const csce::point<T>& p, int side) const {
+			return side * csce::monotone_chain<T>::cross(a, b, p) > 0;
+		}
+	};
+}
+
+#endif /* kirkpatrick_seidel_hpp */
@@ -22,7 +22,7 @@ namespace csce {
 		long double distance_to(const csce::point<T>& p) const {
 			csce::vector2d<T> ab = this->to_vector2d();
 			csce::vector2d<T> bc(this->b, p);
-			T dp = ab.dot(bc);
+			typename csce::orientation::wide<T>::type dp = ab.dot(bc);
 			if(dp > 0){
 				return this->b.distance_to(p);
 			}
@@ -70,12 +70,7 @@ namespace csce {
 		int orientation(const csce::point<T>& p, const csce::point<T>& q, const csce::point<T>& r) const {
 			csce::vector2d<T> pq(p, q);
 			csce::vector2d<T> pr(p, r);
-			T cross_product = pq.cross(pr);
-			
-			if(csce::math_utility::equals_zero(cross_product))
-				return 0;
-			
-			return (cross_product < 0) ? -1 : 1;
+			return pq.orientation(pr);
 		}
 	};
 }
@@ -9,16 +9,80 @@
 #include <cmath>
 #include <algorithm>
 #include <sstream>
+#include <functional>
+#include <cstdint>
+#include <memory>
+#include <type_traits>
 
 #include "point.hpp"
 #include "convex_hull_base.hpp"
 #include "utility.hpp"
 #include "convex_hull_implementations.hpp"
+#include "streaming_hull.hpp"
+#include "approximate_hull.hpp"
+#include "orientation_kernels.hpp"
+#include "point_cloud.hpp"
+#include "point_span.hpp"
+#include "point_file.hpp"
+#include "text_loader.hpp"
 
 #include "test.hpp"
 
 namespace csce {
-	bool algorithm_tuple_comparator (const std::tuple<std::string, long long int, int>& a, const std::tuple<std::string, long long int, int>& b){
+	//the command line options, shared by main (which only looks for -i) and run
+	const char* command_line_options = ":bdDe:f:Him:M:n:o:r:s:t:vV";
+	
+	/**
+	 * Times every orientation kernel variant the processor supports on the points, as both an array of
+	 * points and separate x and y arrays. The edge runs below all of the points, so every kernel has to
+	 * go through all of them: count and mark take the points left of it, find looks for a point right
+	 * of it, and farthest looks for the highest point.
+	 */
+	void benchmark_orientation_kernels(const std::vector<csce::point<double>>& points, int iterations) {
+		csce::point_cloud<double> cloud(points, 8);
+		const double* xs = cloud.x();
+		const double* ys = cloud.y();
+		double low = 0, left = 0, right = 0;
+		for(auto& p : points){
+			low = std::min(low, p.y);
+			left = std::min(left, p.x);
+			right = std::max(right, p.x);
+		}
+		csce::point<double> a(left - 1, low - 1);
+		csce::point<double> b(right + 1, low - 1);
+		std::vector<std::uint64_t> bits((points.size() + 63) / 64);
+		
+		std::vector<std::pair<std::string, std::function<std::size_t()>>> kernels;
+		kernels.push_back(std::make_pair("count (points)", [&]() { return csce::orientation_kernels::count(points.data(), points.size(), a, b, 1); }));
+		kernels.push_back(std::make_pair("count (x[], y[])", [&]() { return csce::orientation_kernels::count(xs, ys, points.size(), a, b, 1); }));
+		kernels.push_back(std::make_pair("mark (points)", [&]() { csce::orientation_kernels::mark(points.data(), points.size(), a, b, 1, bits.data()); return bits[0]; }));
+		kernels.push_back(std::make_pair("mark (x[], y[])", [&]() { csce::orientation_kernels::mark(xs, ys, points.size(), a, b, 1, bits.data()); return bits[0]; }));
+		kernels.push_back(std::make_pair("find (points)", [&]() { return csce::orientation_kernels::find(points.data(), points.size(), a, b, -1); }));
+		kernels.push_back(std::make_pair("find (x[], y[])", [&]() { return csce::orientation_kernels::find(xs, ys, points.size(), a, b, -1); }));
+		kernels.push_back(std::make_pair("farthest (points)", [&]() { return csce::orientation_kernels::farthest(points.data(), points.size(), b, a); }));
+		kernels.push_back(std::make_pair("farthest (x[], y[])", [&]() { return csce::orientation_kernels::farthest(xs, ys, points.size(), b, a); }));
+		
+		csce::orientation_kernels::isa active = csce::orientation_kernels::active();
+		std::size_t checksum = 0;
+		for(auto variant : csce::orientation_kernels::variants()){
+			csce::orientation_kernels::select(variant);
+			std::cout << "-------------------------------------------" << std::endl;
+			std::cout << "Orientation kernels (" << csce::orientation_kernels::name(variant) << ")" << std::endl;
+			for(auto& kernel : kernels){
+				std::chrono::high_resolution_clock::time_point start_time = std::chrono::high_resolution_clock::now();
+				for(int x=0; x<iterations; x++){
+					checksum += kernel.second();
+				}
+				std::chrono::high_resolution_clock::time_point stop_time = std::chrono::high_resolution_clock::now();
+				long long int duration = std::chrono::duration_cast<std::chrono::nanoseconds>(stop_time - start_time).count();
+				std::cout << "   " << kernel.first << ": " << (static_cast<double>(duration) / iterations / std::max<std::size_t>(1, points.size())) << " ns per point" << std::endl;
+			}
+		}
+		csce::orientation_kernels::select(active);
+		std::cout << "(checksum " << checksum << ")" << std::endl;
+	}
+	
+	bool algorithm_tuple_comparator (const std::tuple<std::string, long long int, int, std::size_t>& a, const std::tuple<std::string, long long int, int, std::size_t>& b){
 		return std::get<1>(a) < std::get<1>(b);
 	}
 }
@@ -26,6 +90,7 @@ namespace csce {
 template<typename T>
 int run(int argc, char* argv[]) {
 	int n = 320; //the default number of points. This can be changed by specifying the -n runtime argument.
+	bool n_specified = false; //when loading from a file without -n, every point in the file is loaded
 	int thread_count = std::thread::hardware_concurrency(); //the default number of threads. This can be changed by the -t runtime argument.
 	std::string input_file_path; //where to load data from, if anywhere. If this is not specified, the data will be generated at runtime.
 	std::string output_file_path; //where to write out the generated data, if anywhere.
@@ -35,17 +100,26 @@ int run(int argc, char* argv[]) {
 	bool test_mode = false;
 	bool verbose_validation = false; //if true (set by -v), perform an analysis of each point in the set of points, which is slower but can help with debugging.
 	bool should_validate = true;
+	std::size_t chunk_size = 0; //if set (by -s), the input file is streamed in chunks of this many points instead of being loaded
+	long double epsilon = 0; //if set (by -e), only the approximate hull within epsilon times the diameter is computed
+	bool benchmark_kernels = false; //if set (by -b), only the orientation kernels are benchmarked
+	bool huge_pages = false; //if set (by -H), the algorithms' scratch memory is backed by huge pages and prefaulted
 	
 	std::vector<csce::point<T>> points;
-	std::vector<csce::point<T>> points_copy;
-	std::vector<std::tuple<std::string, long long int, int>> algorithm_tuples;
+	csce::point_span<T> input; //the points that are used from here on: either points, or a mapped binary file
+	std::unique_ptr<csce::point_file> input_file; //a binary input file, which stays mapped while its points are used
+	std::vector<std::tuple<std::string, long long int, int, std::size_t>> algorithm_tuples; //name, total time, correct runs, scratch blocks allocated after the first run
 	
 	T min = -100;
 	T max = 100;
 	
 	int c;
-	while((c = getopt(argc, argv, ":dDf:m:M:n:o:r:t:vV")) != -1){
+	while((c = getopt(argc, argv, csce::command_line_options)) != -1){
 		switch(c){
+			case 'b':
+				benchmark_kernels = true;
+				break;
+				
 			case 'd':
 				debug = true;
 				break;
@@ -54,12 +128,23 @@ int run(int argc, char* argv[]) {
 				test_mode = true;
 				break;
 				
+			case 'e':
+				if(optarg != NULL){
+					std::stringstream argument_stream(optarg);
+					argument_stream >> epsilon;
+				}
+				break;
+				
 			case 'f':
 				if(optarg != NULL){
 					input_file_path = std::string(optarg);
 				}
 				break;
 				
+			case 'H':
+				huge_pages = true;
+				break;
+				
 			case 'm':
 				if(optarg != NULL){
 					std::stringstream argument_stream(optarg);
@@ -78,6 +163,7 @@ int run(int argc, char* argv[]) {
 				if(optarg != NULL){
 					std::stringstream argument_stream(optarg);
 					argument_stream >> n;
+					n_specified = true;
 				}
 				break;
 				
@@ -94,6 +180,13 @@ int run(int argc, char* argv[]) {
 				}
 				break;
 				
+			case 's':
+				if(optarg != NULL){
+					std::stringstream argument_stream(optarg);
+					argument_stream >> chunk_size;
+				}
+				break;
+				
 			case 't':
 				if(optarg != NULL){
 					std::stringstream argument_stream(optarg);
@@ -128,6 +221,35 @@ int run(int argc, char* argv[]) {
 	}
 	
 	
+	//
+	// streaming mode - the input file is never loaded as a whole, so only the streaming hull can run
+	//
+	if(chunk_size > 0){
+		if(input_file_path.empty()){
+			std::cout << "Streaming (-s) needs an input file (-f), ignoring it." << std::endl;
+		} else {
+			std::cout << "Streaming points from (" << input_file_path << ") in chunks of " << chunk_size << " points ... " << std::flush;
+			csce::streaming_hull<T> streaming(thread_count, chunk_size);
+			
+			std::chrono::high_resolution_clock::time_point start_time = std::chrono::high_resolution_clock::now();
+			std::vector<csce::point<T>> hull_points = streaming.compute_hull(input_file_path);
+			std::chrono::high_resolution_clock::time_point stop_time = std::chrono::high_resolution_clock::now();
+			duration = std::chrono::duration_cast<std::chrono::nanoseconds>(stop_time - start_time).count();
+			
+			std::cout << "done in " << csce::utility::duration_string(duration) << " (" << streaming.summary() << ")" << std::endl;
+			std::cout << "Convex hull contains " << hull_points.size() << " points." << std::endl;
+			if(debug){
+				std::cout << "-------" << std::endl;
+				for(std::size_t y=0; y<hull_points.size(); y++){
+					std::cout << "   " << y << "\t" << hull_points[y].str() << std::endl;
+				}
+				std::cout << "-------" << std::endl;
+			}
+			return 0;
+		}
+	}
+	
+	
 	//
 	//first - load the values into the array, either by populating it
 	//        with random values or by reading the values from a file.
@@ -136,12 +258,43 @@ int run(int argc, char* argv[]) {
 		//no input file was specified, so populate the array with random numbers
 		std::cout << "Populating array with " << n << " points with values between [" << min << ", " << max << "] ... " << std::flush;
 		points = csce::utility::random_points<T>(n, min, max);
+	} else if(csce::point_file::detect(input_file_path)){
+		//map the binary file, and use its points in place if they have the right type and layout
+		std::cout << "Mapping points from the binary file (" << input_file_path << ") ... " << std::flush;
+		input_file.reset(new csce::point_file(input_file_path));
+		std::size_t limit = n_specified ? static_cast<std::size_t>(n) : 0;
+		if(input_file->maps<T>()){
+			input_file->prefault(*csce::shared_executor(thread_count));
+			input = input_file->span<T>(limit);
+		} else {
+			points = input_file->to_vector<T>(limit, *csce::shared_executor(thread_count));
+		}
+		max = std::max(max, input_file->upper<T>().x); //the validation casts rays to the right of every point
+		std::size_t loaded = input.empty() ? points.size() : input.size();
+		std::cout << "loaded " << loaded << " points ";
+		if(loaded < input_file->size()){
+			std::cout << "(-n keeps the first " << loaded << " of the file's " << input_file->size() << ") ";
+		} else if(n_specified && loaded < static_cast<std::size_t>(n)){
+			std::cout << "(-n asked for " << n << ", but the file only has " << loaded << ") ";
+		}
+		std::cout << "... " << std::flush;
 	} else {
 		//load from the specified file
 		std::cout << "Populating array with points from the file (" << input_file_path << ") ... " << std::flush;
-		points = csce::utility::points_from_file<T>(n, input_file_path);
-		std::cout << "loaded " << points.size() << " points ... " << std::flush;
+		std::size_t total = 0;
+		points = csce::text_loader::load<T>(input_file_path, n_specified ? static_cast<std::size_t>(n) : 0, *csce::shared_executor(thread_count), &total);
+		std::cout << "loaded " << points.size() << " points ";
+		if(points.size() < total){
+			std::cout << "(-n keeps the first " << points.size() << " of the file's " << total << ") ";
+		} else if(n_specified && points.size() < static_cast<std::size_t>(n)){
+			std::cout << "(-n asked for " << n << ", but the file only has " << total << ") ";
+		}
+		std::cout << "... " << std::flush;
+	}
+	if(input.empty()){
+		input = csce::point_span<T>(points);
 	}
+	n = static_cast<int>(input.size());
 	std::cout << "done." << std::endl;
 	
 	
@@ -151,18 +304,68 @@ int run(int argc, char* argv[]) {
 	//
 	if(!output_file_path.empty()){
 		std::cout << "Writing array to file (" << output_file_path << ") ... " << std::flush;
-		csce::utility::write_to_file(points, output_file_path);
+		if(csce::point_file::compressed_path(output_file_path) && std::is_integral<T>::value){
+			csce::point_file::write(input, output_file_path, *csce::shared_executor(thread_count), csce::point_file::compressed);
+		} else if(csce::point_file::binary_path(output_file_path) || csce::point_file::compressed_path(output_file_path)){
+			if(!std::is_integral<T>::value && csce::point_file::compressed_path(output_file_path)){
+				std::cout << "(only integer coordinates (-i) can be compressed, so the file is not) " << std::flush;
+			}
+			csce::point_file::write(input, output_file_path, *csce::shared_executor(thread_count));
+		} else {
+			csce::utility::write_to_file(input, output_file_path);
+		}
 		std::cout << "done." << std::endl;
 	}
 	
 	
 	
+	//
+	// kernel benchmark mode - times the orientation kernels on the points instead of running the algorithms
+	//
+	if(benchmark_kernels){
+		std::vector<csce::point<double>> double_points;
+		double_points.reserve(input.size());
+		for(auto& p : input){
+			double_points.push_back(csce::point<double>(p.x, p.y));
+		}
+		csce::benchmark_orientation_kernels(double_points, std::max(1, iterations));
+		return 0;
+	}
+	
+	
+	
+	//
+	// approximate mode - the approximate hull does not contain every point, so it replaces the exact algorithms
+	//
+	if(epsilon > 0){
+		csce::approximate_hull<T> approximate(thread_count, epsilon);
+		std::cout << "Computing " << approximate.name() << " ... " << std::flush;
+		
+		std::chrono::high_resolution_clock::time_point start_time = std::chrono::high_resolution_clock::now();
+		std::vector<csce::point<T>> hull_points = approximate.compute_hull(input);
+		std::chrono::high_resolution_clock::time_point stop_time = std::chrono::high_resolution_clock::now();
+		duration = std::chrono::duration_cast<std::chrono::nanoseconds>(stop_time - start_time).count();
+		
+		std::cout << "done in " << csce::utility::duration_string(duration) << " (" << approximate.summary() << ")" << std::endl;
+		std::cout << "Convex hull contains " << hull_points.size() << " / " << n << " points." << std::endl;
+		if(debug){
+			std::cout << "-------" << std::endl;
+			for(std::size_t y=0; y<hull_points.size(); y++){
+				std::cout << "   " << y << "\t" << hull_points[y].str() << std::endl;
+			}
+			std::cout << "-------" << std::endl;
+		}
+		return 0;
+	}
+	
+	
+	
 	//if running in debug mode, print the values of the array
 	if(debug){
 		std::cout << "Running in debug mode ... printing array" << std::endl;
 		std::cout << "-------" << std::endl;
-		for(std::size_t x=0; x<points.size(); x++){
-			std::cout << x << "\t" << points[x].str() << std::endl;
+		for(std::size_t x=0; x<input.size(); x++){
+			std::cout << x << "\t" << input[x].str() << std::endl;
 		}
 		std::cout << "-------" << std::endl;
 		std::cout << "done printing array" << std::endl << std::endl;
@@ -179,6 +382,16 @@ int run(int argc, char* argv[]) {
 
 	std::vector<csce::point<T>> validated_hull; //this is used to improve validation speed, but can be turned off using the -v flag for more verbose validation
 	
+	//the algorithms are kept for every iteration, so that later runs reuse their scratch memory
+	std::vector<csce::convex_hull_base<T>*> algorithms = csce::convex_hull_implementations::list<T>(thread_count);
+	algorithm_tuples.reserve(algorithms.size());
+	for(auto& algorithm : algorithms){
+		algorithm_tuples.push_back(std::make_tuple(algorithm->name(), 0L, 0, static_cast<std::size_t>(0)));
+		if(huge_pages){
+			algorithm->set_arena(std::make_shared<csce::scratch_arena>(true, true));
+		}
+	}
+	
 	for(int iteration = 0; iteration < iterations; iteration++){
 		if(iterations > 1){
 			std::cout << "***********************************" << std::endl;
@@ -186,28 +399,27 @@ int run(int argc, char* argv[]) {
 			std::cout << "***********************************" << std::endl;
 		}
 		
-		std::vector<csce::convex_hull_base<T>*> algorithms = csce::convex_hull_implementations::list<T>(thread_count);
-		if(iteration == 0){
-			algorithm_tuples.reserve(algorithms.size());
-			for(auto& algorithm : algorithms){
-				algorithm_tuples.push_back(std::make_tuple(algorithm->name(), 0L, 0));
-			}
-		}
-		
 		for(std::size_t x=0; x<algorithms.size(); x++){
-			points_copy = points;
-			
 			std::cout << "-------------------------------------------" << std::endl;
 			std::cout << "Testing convex hull implementation (" << algorithms[x]->name() << ")" << std::endl;
 			std::cout << "Computing convex hull ... " << std::flush;
 			
+			std::size_t blocks = algorithms[x]->get_arena()->block_allocations();
 			std::chrono::high_resolution_clock::time_point start_time = std::chrono::high_resolution_clock::now();
-			std::vector<csce::point<T>> hull_points = algorithms[x]->compute_hull(points_copy);
+			std::vector<csce::point<T>> hull_points = algorithms[x]->compute_hull(input); //the points are shared by every run, so they must not change
 			std::chrono::high_resolution_clock::time_point stop_time = std::chrono::high_resolution_clock::now();
 			duration = std::chrono::duration_cast<std::chrono::nanoseconds>(stop_time - start_time).count();
 			std::get<1>(algorithm_tuples[x]) += duration;
+			if(iteration > 0){
+				std::get<3>(algorithm_tuples[x]) += algorithms[x]->get_arena()->block_allocations() - blocks;
+			}
 			
-			std::cout << "done in " << csce::utility::duration_string(duration) << std::endl;
+			std::cout << "done in " << csce::utility::duration_string(duration);
+			std::string summary = algorithms[x]->summary();
+			if(!summary.empty()){
+				std::cout << " (" << summary << ")";
+			}
+			std::cout << std::endl;
 			
 			//if running in debug mode, print the values of the array
 			if(debug){
@@ -226,7 +438,7 @@ int run(int argc, char* argv[]) {
 
 				bool valid = true;
 				if(verbose_validation || validated_hull.empty()){
-					valid = csce::utility::validate<T>(hull_points, points, max, error_messages);
+					valid = csce::utility::validate<T>(hull_points, input, max, error_messages);
 					if(!verbose_validation && valid){
 						validated_hull = hull_points;
 					}
@@ -252,16 +464,16 @@ int run(int argc, char* argv[]) {
 			std::cout << "-------------------------------------------" << std::endl;
 		}
 		
-		//clean up the pointers
-		for(auto& algorithm : algorithms){
-			delete algorithm;
-		}
-		
 		if(iterations > 1){
 			std::cout << std::endl;
 		}
 	}
 	
+	//clean up the pointers
+	for(auto& algorithm : algorithms){
+		delete algorithm;
+	}
+	
 	std::sort(algorithm_tuples.begin(), algorithm_tuples.end(), csce::algorithm_tuple_comparator);
 	
 	std::cout << std::endl;
@@ -273,7 +485,8 @@ int run(int argc, char* argv[]) {
 		std::string sort_name;
 		long long int sort_duration = 0L;
 		int sort_correct = 0;
-		std::tie(sort_name, sort_duration, sort_correct) = algorithm_tuples[x];
+		std::size_t sort_blocks = 0;
+		std::tie(sort_name, sort_duration, sort_correct, sort_blocks) = algorithm_tuples[x];
 		
 		std::cout << "==" << std::endl;
 		std::cout << "== " << sort_name << std::endl;
@@ -282,6 +495,9 @@ int run(int argc, char* argv[]) {
 		
 		long double correct_percent = 100.0L * static_cast<long double>(sort_correct) / static_cast<long double>(iterations);
 		std::cout << "==      Correct: " << correct_percent << "%  (" << sort_correct << " / " << iterations << ")" << std::endl;
+		if(iterations > 1){
+			std::cout << "==      Scratch: " << sort_blocks << " blocks allocated after the first run" << std::endl;
+		}
 		std::cout << "==" << std::endl;
 	}
 	
@@ -291,5 +507,19 @@ int run(int argc, char* argv[]) {
 }
 
 int main(int argc, char* argv[]) {
-	run<long double>(argc, argv);
+	//-i runs everything with exact 64-bit integer coordinates instead of floating point ones
+	bool integer_coordinates = false;
+	int c;
+	while((c = getopt(argc, argv, csce::command_line_options)) != -1){
+		if(c == 'i'){
+			integer_coordinates = true;
+		}
+	}
+	optind = 1;
+	
+	if(integer_coordinates){
+		run<long long int>(argc, argv);
+	} else {
+		run<double>(argc, argv);
+	}
 }
@@ -0,0 +1,119 @@
+#ifndef monotone_chain_hpp
+#define monotone_chain_hpp
+
+#include <vector>
+#include <string>
+#include <algorithm>
+
+#include "convex_hull_base.hpp"
+#include "point.hpp"
+#include "orientation.hpp"
+
+namespace csce {
+	template<typename T>
+	class monotone_chain : public csce::convex_hull_base<T> {
+	public:
+		using csce::convex_hull_base<T>::compute_hull;
+		
+		monotone_chain(int _nthreads) : csce::convex_hull_base<T>(_nthreads) {}
+
+
+		std::string name() const {
+			return "Monotone Chain";
+		}
+
+
+		virtual std::vector<csce::point<T>> compute_hull(std::vector<csce::point<T>>& points) {
+			if(points.size() <= 3){
+				return points;
+			}
+
+			std::sort(points.begin(), points.end(), csce::monotone_chain<T>::lexicographic_less);
+
+			std::vector<csce::point<T>> lower = csce::monotone_chain<T>::lower_chain(points.begin(), points.end());
+			std::vector<csce::point<T>> upper = csce::monotone_chain<T>::upper_chain(points.begin(), points.end());
+			return csce::monotone_chain<T>::join_chains(lower, upper);
+		}
+
+
+		~monotone_chain() {}
+
+
+		/**
+		 * Orders points by x coordinate, breaking ties by y coordinate.
+		 */
+		static bool lexicographic_less(const csce::point<T>& a, const csce::point<T>& b) {
+			return a.x < b.x || (a.x == b.x && a.y < b.y);
+		}
+
+
+		/**
+		 * Builds the lower chain of the lexicographically sorted points in [begin, end).
+		 * The chain runs from the left-most point to the right-most point and only keeps
+		 * points where the chain turns counterclockwise.
+		 */
+		template<typename Iterator>
+		static std::vector<csce::point<T>> lower_chain(Iterator begin, Iterator end) {
+			std::vector<csce::point<T>> chain;
+			for(Iterator it = begin; it != end; it++){
+				while(chain.size() >= 2 && csce::monotone_chain<T>::cross(chain[chain.size() - 2], chain.back(), *it) <= 0){
+					chain.pop_back();
+				}
+				if(chain.empty() || chain.back() != *it){
+					chain.push_back(*it);
+				}
+			}
+			return chain;
+		}
+
+
+		/**
+		 * Builds the upper chain of the lexicographically sorted points in [begin, end).
+		 * Like the lower chain, it runs from the left-most point to the right-most point,
+		 * but only keeps points where the chain turns clockwise.
+		 */
+		template<typename Iterator>
+		static std::vector<csce::point<T>> upper_chain(Iterator begin, Iterator end) {
+			std::vector<csce::point<T>> chain;
+			for(Iterator it = begin; it != end; it++){
+				while(chain.size() >= 2 && csce::monotone_chain<T>::cross(chain[chain.size() - 2], chain.back(), *it) >= 0){
+					chain.pop_back();
+				}
+				if(chain.empty() || chain.back() != *it){
+					chain.push_back(*it);
+				}
+			}
+			return chain;
+		}
+
+
+		/**
+		 * Joins a lower and an upper chain that share their end points into a single
+		 * counterclockwise polygon starting at the left-most point.
+		 */
+		static std::vector<csce::point<T>> join_chains(const std::vector<csce::point<T>>& lower, const std::vector<csce::point<T>>& upper) {
+			std::vector<csce::point<T>> hull(lower);
+			if(lower.size() <= 1){
+				return hull; //all of the points are identical
+			}
+
+			hull.reserve(lower.size() + upper.size());
+			for(std::size_t x = upper.size() - 2; x > 0; x--){
+				hull.push_back(upper[x]);
+			}
+			return hull;
+		}
+
+
+		/**
+		 * Returns the cross product of o->a and o->b. It is positive if o, a, b make a
+		 * counterclockwise turn, negative if they make a clockwise turn, and zero if they
+		 * are collinear. Integer coordinates are widened first, so the result is exact.
+		 */
+		static typename csce::orientation::wide<T>::type cross(const csce::point<T>& o, const csce::point<T>& a, const csce::point<T>& b) {
+			return csce::orientation::cross(o, a, b);
+		}
+	};
+}
+
+#endif /* monotone_chain_hpp */
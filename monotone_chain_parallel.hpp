@@ -0,0 +1,66 @@
+#ifndef monotone_chain_parallel_hpp
+#define monotone_chain_parallel_hpp
+
+#include <vector>
+#include <string>
+#include <algorithm>
+
+#include "convex_hull_base.hpp"
+#include "point.hpp"
+#include "monotone_chain.hpp"
+#include "sort_parallel.hpp"
+
+namespace csce {
+	template<typename T>
+	class monotone_chain_parallel : public csce::convex_hull_base<T> {
+	public:
+		using csce::convex_hull_base<T>::compute_hull;
+		
+		monotone_chain_parallel(int _nthreads) : csce::convex_hull_base<T>(_nthreads) {}
+
+
+		std::string name() const {
+			return "Monotone Chain Parallel";
+		}
+
+
+		std::vector<csce::point<T>> compute_hull(std::vector<csce::point<T>>& points) {
+			if(points.size() <= 1600 || this->nthreads < 2){
+				//if the input size is small enough, it is better to run the
+				//sequential version of this algorithm.
+				csce::monotone_chain<T> sequential(this->nthreads);
+				return sequential.compute_hull(points);
+			}
+
+			csce::scratch_arena::scope scope(this->scratch());
+			csce::monotone_chain_parallel<T>::sort_array(points, this->executor(), &this->scratch());
+
+			//the lower and upper chains only depend on the sorted points, so build them at the same time
+			std::vector<csce::point<T>> lower;
+			std::vector<csce::point<T>> upper;
+			this->executor().fork_join(2, [&](std::size_t chain) {
+				if(chain == 0){
+					upper = csce::monotone_chain<T>::upper_chain(points.begin(), points.end());
+				} else {
+					lower = csce::monotone_chain<T>::lower_chain(points.begin(), points.end());
+				}
+			});
+
+			return csce::monotone_chain<T>::join_chains(lower, upper);
+		}
+
+
+		~monotone_chain_parallel() {}
+
+
+		/**
+		 * Sorts the points lexicographically with a parallel merge sort (see sort_parallel), whose
+		 * buffer comes from the arena if there is one.
+		 */
+		static void sort_array(std::vector<csce::point<T>>& points, csce::executor& pool, csce::scratch_arena* arena = nullptr) {
+			csce::sort_parallel<T, bool (*)(const csce::point<T>&, const csce::point<T>&)>(csce::monotone_chain<T>::lexicographic_less, pool, arena).sort_array(points.begin(), points.end());
+		}
+	};
+}
+
+#endif /* monotone_chain_parallel_hpp */
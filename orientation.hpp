@@ -0,0 +1,130 @@
+#ifndef orientation_hpp
+#define orientation_hpp
+
+#include <cstdint>
+#include <type_traits>
+
+#include "point.hpp"
+#include "math_utility.hpp"
+#include "robust_predicates.hpp"
+
+namespace csce {
+	namespace orientation {
+		/**
+		 * The type that products of T coordinate differences are computed in. Integer coordinates are
+		 * widened to twice their size so that the products cannot overflow: cross products are exact for
+		 * 32-bit coordinates below 2^30 and 64-bit coordinates below 2^62 in magnitude (so that the
+		 * differences still fit in the coordinate type). Floating point types are used as they are;
+		 * double cross products get their exact sign from robust_predicates instead.
+		 */
+		template<typename T>
+		struct wide {
+			typedef T type;
+		};
+
+		template<>
+		struct wide<short> {
+			typedef std::int32_t type;
+		};
+
+		template<>
+		struct wide<int> {
+			typedef std::int64_t type;
+		};
+
+		template<>
+		struct wide<long> {
+			typedef __int128 type;
+		};
+
+		template<>
+		struct wide<long long> {
+			typedef __int128 type;
+		};
+
+
+		/**
+		 * Returns the cross product of o->a and o->b. It is positive if o, a, b make a counterclockwise
+		 * turn, negative if they make a clockwise turn, and zero if they are collinear.
+		 */
+		template<typename T>
+		typename wide<T>::type cross(const csce::point<T>& o, const csce::point<T>& a, const csce::point<T>& b) {
+			typedef typename wide<T>::type W;
+			return static_cast<W>(a.x - o.x) * static_cast<W>(b.y - o.y) - static_cast<W>(a.y - o.y) * static_cast<W>(b.x - o.x);
+		}
+
+
+		/**
+		 * For double coordinates the cross product is computed by the adaptive predicate, so that its
+		 * sign is exact and collinear points are detected without an epsilon.
+		 */
+		inline double cross(const csce::point<double>& o, const csce::point<double>& a, const csce::point<double>& b) {
+			return csce::robust_predicates::orient2d(o.x, o.y, a.x, a.y, b.x, b.y);
+		}
+
+
+		/**
+		 * Whether the sign of a cross product computed from T coordinates is exact: integer products
+		 * are computed exactly in the wide type, and double ones by the adaptive predicate.
+		 */
+		template<typename T>
+		struct exact : std::integral_constant<bool, std::is_integral<T>::value || std::is_same<T, double>::value> {};
+
+
+		/**
+		 * Returns the dot product of o->a and o->b.
+		 */
+		template<typename T>
+		typename wide<T>::type dot(const csce::point<T>& o, const csce::point<T>& a, const csce::point<T>& b) {
+			typedef typename wide<T>::type W;
+			return static_cast<W>(a.x - o.x) * static_cast<W>(b.x - o.x) + static_cast<W>(a.y - o.y) * static_cast<W>(b.y - o.y);
+		}
+
+
+		/**
+		 * Returns the squared distance between a and b, which can be compared without a square root.
+		 */
+		template<typename T>
+		typename wide<T>::type squared_distance(const csce::point<T>& a, const csce::point<T>& b) {
+			return csce::orientation::dot(a, b, b);
+		}
+
+
+		template<typename W>
+		int sign(W value, std::true_type) {
+			return (value > 0) - (value < 0);
+		}
+
+
+		template<typename W>
+		int sign(W value, std::false_type) {
+			if(csce::math_utility::equals_zero(value)){
+				return 0;
+			}
+			return (value < 0) ? -1 : 1;
+		}
+
+
+		/**
+		 * Returns -1, 0 or +1 for the sign of a product computed from T coordinates. Integer products,
+		 * and double ones from cross (which robust_predicates::orient2d computes), have exact signs, so
+		 * they are compared against zero directly, without branches. float and long double products
+		 * within EPS of zero count as zero.
+		 */
+		template<typename T>
+		int sign(typename wide<T>::type value) {
+			return csce::orientation::sign(value, csce::orientation::exact<T>());
+		}
+
+
+		/**
+		 * Returns +1 if o, a, b make a counterclockwise turn, -1 if they make a clockwise turn and 0 if they are collinear.
+		 */
+		template<typename T>
+		int turn(const csce::point<T>& o, const csce::point<T>& a, const csce::point<T>& b) {
+			return csce::orientation::sign<T>(csce::orientation::cross(o, a, b));
+		}
+	}
+}
+
+#endif /* orientation_hpp */
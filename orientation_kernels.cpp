@@ -0,0 +1,577 @@
+#include <atomic>
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <immintrin.h>
+
+#include "orientation_kernels.hpp"
+#include "robust_predicates.hpp"
+
+//Every variant runs the same loop bodies below, written against a small set of vector operations.
+//The bodies are always inlined into wrappers compiled for one instruction set each (with the
+//GCC target pragmas further down), so the operations are inlined as that instruction set too
+//while the rest of the program is still built for the baseline processor. GCC warns that the
+//bodies pass vector registers around before they are inlined, which never happens at run time.
+//Contracting the products into fused multiply-adds would break orient2d's error bound.
+#pragma GCC diagnostic ignored "-Wpsabi"
+#pragma GCC optimize("fp-contract=off")
+
+namespace {
+	typedef std::uint64_t word;
+
+	static_assert(sizeof(csce::point<double>) == 2 * sizeof(double), "The interleaved kernels read points as pairs of doubles");
+
+	struct edge {
+		double ax, ay, bx, by;
+	};
+
+	//separate x[] and y[] arrays
+	struct soa {
+		const double* x;
+		const double* y;
+
+		double px(std::size_t i) const {
+			return this->x[i];
+		}
+
+		double py(std::size_t i) const {
+			return this->y[i];
+		}
+
+		template<typename Ops>
+		inline __attribute__((always_inline)) void load(std::size_t i, typename Ops::reg& px, typename Ops::reg& py) const {
+			px = Ops::load(this->x + i);
+			py = Ops::load(this->y + i);
+		}
+	};
+
+	//x and y interleaved, as in an array of points
+	struct aos {
+		const double* xy;
+
+		double px(std::size_t i) const {
+			return this->xy[2 * i];
+		}
+
+		double py(std::size_t i) const {
+			return this->xy[2 * i + 1];
+		}
+
+		template<typename Ops>
+		inline __attribute__((always_inline)) void load(std::size_t i, typename Ops::reg& px, typename Ops::reg& py) const {
+			Ops::load_pairs(this->xy + 2 * i, px, py);
+		}
+	};
+
+
+	/**
+	 * Sets the bits of the points in [begin, begin + n) that are certainly left of (positive) or
+	 * right of (negative) the edge, and of the ones that are too close to its line to tell
+	 * (uncertain). n is at most 64 times the number of words, and the words start out cleared.
+	 */
+	template<typename Ops, typename Layout>
+	inline __attribute__((always_inline)) void classify_body(const Layout& in, std::size_t begin, std::size_t n, const edge& e, word* positive, word* negative, word* uncertain) {
+		typedef typename Ops::reg reg;
+		const double bound = csce::robust_predicates::orient2d_error_bound;
+		reg ax = Ops::set1(e.ax), ay = Ops::set1(e.ay), bx = Ops::set1(e.bx), by = Ops::set1(e.by);
+		reg error_bound = Ops::set1(bound);
+		reg zero = Ops::set1(0);
+
+		std::size_t x = 0;
+		for(; x + Ops::width <= n; x += Ops::width){
+			reg px, py;
+			in.template load<Ops>(begin + x, px, py);
+			reg left = Ops::mul(Ops::sub(ax, px), Ops::sub(by, py));
+			reg right = Ops::mul(Ops::sub(ay, py), Ops::sub(bx, px));
+			reg det = Ops::sub(left, right);
+			reg limit = Ops::mul(error_bound, Ops::add(Ops::abs(left), Ops::abs(right)));
+			word pos = Ops::bits(Ops::greater(det, limit));
+			word neg = Ops::bits(Ops::greater(Ops::sub(zero, det), limit));
+			positive[x / 64] |= pos << (x % 64);
+			negative[x / 64] |= neg << (x % 64);
+			uncertain[x / 64] |= (~(pos | neg) & ((word(1) << Ops::width) - 1)) << (x % 64);
+		}
+		for(; x < n; x++){
+			double px = in.px(begin + x);
+			double py = in.py(begin + x);
+			double left = (e.ax - px) * (e.by - py);
+			double right = (e.ay - py) * (e.bx - px);
+			double det = left - right;
+			double limit = bound * (std::abs(left) + std::abs(right));
+			word bit = word(1) << (x % 64);
+			if(det > limit){
+				positive[x / 64] |= bit;
+			} else if(-det > limit){
+				negative[x / 64] |= bit;
+			} else {
+				uncertain[x / 64] |= bit;
+			}
+		}
+	}
+
+
+	/**
+	 * The index (from begin) of the point in [begin, begin + n) with the most negative signed
+	 * area, ties going to the one farthest along the edge and then to the first one.
+	 */
+	template<typename Ops, typename Layout>
+	inline __attribute__((always_inline)) std::size_t farthest_body(const Layout& in, std::size_t begin, std::size_t n, const edge& e) {
+		typedef typename Ops::reg reg;
+		reg ax = Ops::set1(e.ax), ay = Ops::set1(e.ay), bx = Ops::set1(e.bx), by = Ops::set1(e.by);
+		reg abx = Ops::sub(bx, ax), aby = Ops::sub(by, ay);
+
+		//every lane keeps its own best point, with the index stored as a double (exact below 2^53)
+		double infinity = std::numeric_limits<double>::infinity();
+		reg best_area = Ops::set1(infinity);
+		reg best_along = Ops::set1(-infinity);
+		reg best_index = Ops::set1(-1);
+		reg index = Ops::iota();
+		reg step = Ops::set1(Ops::width);
+
+		std::size_t x = 0;
+		for(; x + Ops::width <= n; x += Ops::width){
+			reg px, py;
+			in.template load<Ops>(begin + x, px, py);
+			reg area = Ops::sub(Ops::mul(Ops::sub(ax, px), Ops::sub(by, py)), Ops::mul(Ops::sub(ay, py), Ops::sub(bx, px)));
+			reg along = Ops::add(Ops::mul(Ops::sub(px, ax), abx), Ops::mul(Ops::sub(py, ay), aby));
+			typename Ops::mask better = Ops::either(Ops::greater(best_area, area), Ops::both(Ops::equal(area, best_area), Ops::greater(along, best_along)));
+			best_area = Ops::blend(better, best_area, area);
+			best_along = Ops::blend(better, best_along, along);
+			best_index = Ops::blend(better, best_index, index);
+			index = Ops::add(index, step);
+		}
+
+		double areas[Ops::width], alongs[Ops::width], indices[Ops::width];
+		Ops::store(areas, best_area);
+		Ops::store(alongs, best_along);
+		Ops::store(indices, best_index);
+		std::size_t best = n;
+		double area_of_best = infinity, along_of_best = -infinity;
+		auto consider = [&](std::size_t i, double area, double along) {
+			if(area < area_of_best || (area == area_of_best && (along > along_of_best || (along == along_of_best && i < best)))){
+				best = i;
+				area_of_best = area;
+				along_of_best = along;
+			}
+		};
+		for(std::size_t lane=0; lane<Ops::width; lane++){
+			if(indices[lane] >= 0){
+				consider(static_cast<std::size_t>(indices[lane]), areas[lane], alongs[lane]);
+			}
+		}
+		for(; x < n; x++){
+			double px = in.px(begin + x);
+			double py = in.py(begin + x);
+			consider(x, (e.ax - px) * (e.by - py) - (e.ay - py) * (e.bx - px), (px - e.ax) * (e.bx - e.ax) + (py - e.ay) * (e.by - e.ay));
+		}
+		return best;
+	}
+
+
+	struct scalar_ops {
+		typedef double reg;
+		typedef bool mask;
+		static const std::size_t width = 1;
+
+		static reg set1(double a) { return a; }
+		static reg iota() { return 0; }
+		static reg load(const double* p) { return *p; }
+		static void load_pairs(const double* p, reg& x, reg& y) { x = p[0]; y = p[1]; }
+		static void store(double* p, reg a) { *p = a; }
+		static reg add(reg a, reg b) { return a + b; }
+		static reg sub(reg a, reg b) { return a - b; }
+		static reg mul(reg a, reg b) { return a * b; }
+		static reg abs(reg a) { return std::abs(a); }
+		static mask greater(reg a, reg b) { return a > b; }
+		static mask equal(reg a, reg b) { return a == b; }
+		static mask both(mask a, mask b) { return a && b; }
+		static mask either(mask a, mask b) { return a || b; }
+		static reg blend(mask m, reg a, reg b) { return m ? b : a; }
+		static word bits(mask m) { return m; }
+	};
+}
+
+
+#pragma GCC push_options
+#pragma GCC target("sse2")
+namespace {
+	struct sse2_ops {
+		typedef __m128d reg;
+		typedef __m128d mask;
+		static const std::size_t width = 2;
+
+		static reg set1(double a) { return _mm_set1_pd(a); }
+		static reg iota() { return _mm_set_pd(1, 0); }
+		static reg load(const double* p) { return _mm_loadu_pd(p); }
+		static void load_pairs(const double* p, reg& x, reg& y) {
+			reg first = _mm_loadu_pd(p);
+			reg second = _mm_loadu_pd(p + 2);
+			x = _mm_unpacklo_pd(first, second);
+			y = _mm_unpackhi_pd(first, second);
+		}
+		static void store(double* p, reg a) { _mm_storeu_pd(p, a); }
+		static reg add(reg a, reg b) { return _mm_add_pd(a, b); }
+		static reg sub(reg a, reg b) { return _mm_sub_pd(a, b); }
+		static reg mul(reg a, reg b) { return _mm_mul_pd(a, b); }
+		static reg abs(reg a) { return _mm_andnot_pd(_mm_set1_pd(-0.0), a); }
+		static mask greater(reg a, reg b) { return _mm_cmpgt_pd(a, b); }
+		static mask equal(reg a, reg b) { return _mm_cmpeq_pd(a, b); }
+		static mask both(mask a, mask b) { return _mm_and_pd(a, b); }
+		static mask either(mask a, mask b) { return _mm_or_pd(a, b); }
+		static reg blend(mask m, reg a, reg b) { return _mm_or_pd(_mm_and_pd(m, b), _mm_andnot_pd(m, a)); }
+		static word bits(mask m) { return _mm_movemask_pd(m); }
+	};
+
+	void classify_soa_sse2(const soa& in, std::size_t begin, std::size_t n, const edge& e, word* positive, word* negative, word* uncertain) {
+		classify_body<sse2_ops>(in, begin, n, e, positive, negative, uncertain);
+	}
+
+	void classify_aos_sse2(const aos& in, std::size_t begin, std::size_t n, const edge& e, word* positive, word* negative, word* uncertain) {
+		classify_body<sse2_ops>(in, begin, n, e, positive, negative, uncertain);
+	}
+
+	std::size_t farthest_soa_sse2(const soa& in, std::size_t begin, std::size_t n, const edge& e) {
+		return farthest_body<sse2_ops>(in, begin, n, e);
+	}
+
+	std::size_t farthest_aos_sse2(const aos& in, std::size_t begin, std::size_t n, const edge& e) {
+		return farthest_body<sse2_ops>(in, begin, n, e);
+	}
+}
+#pragma GCC pop_options
+
+
+#pragma GCC push_options
+#pragma GCC target("avx2")
+namespace {
+	struct avx2_ops {
+		typedef __m256d reg;
+		typedef __m256d mask;
+		static const std::size_t width = 4;
+
+		static reg set1(double a) { return _mm256_set1_pd(a); }
+		static reg iota() { return _mm256_set_pd(3, 2, 1, 0); }
+		static reg load(const double* p) { return _mm256_loadu_pd(p); }
+		static void load_pairs(const double* p, reg& x, reg& y) {
+			//the unpacks give the points in the order 0, 2, 1, 3, which the permutes put back
+			reg first = _mm256_loadu_pd(p);
+			reg second = _mm256_loadu_pd(p + 4);
+			x = _mm256_permute4x64_pd(_mm256_unpacklo_pd(first, second), 0xD8);
+			y = _mm256_permute4x64_pd(_mm256_unpackhi_pd(first, second), 0xD8);
+		}
+		static void store(double* p, reg a) { _mm256_storeu_pd(p, a); }
+		static reg add(reg a, reg b) { return _mm256_add_pd(a, b); }
+		static reg sub(reg a, reg b) { return _mm256_sub_pd(a, b); }
+		static reg mul(reg a, reg b) { return _mm256_mul_pd(a, b); }
+		static reg abs(reg a) { return _mm256_andnot_pd(_mm256_set1_pd(-0.0), a); }
+		static mask greater(reg a, reg b) { return _mm256_cmp_pd(a, b, _CMP_GT_OQ); }
+		static mask equal(reg a, reg b) { return _mm256_cmp_pd(a, b, _CMP_EQ_OQ); }
+		static mask both(mask a, mask b) { return _mm256_and_pd(a, b); }
+		static mask either(mask a, mask b) { return _mm256_or_pd(a, b); }
+		static reg blend(mask m, reg a, reg b) { return _mm256_blendv_pd(a, b, m); }
+		static word bits(mask m) { return _mm256_movemask_pd(m); }
+	};
+
+	void classify_soa_avx2(const soa& in, std::size_t begin, std::size_t n, const edge& e, word* positive, word* negative, word* uncertain) {
+		classify_body<avx2_ops>(in, begin, n, e, positive, negative, uncertain);
+	}
+
+	void classify_aos_avx2(const aos& in, std::size_t begin, std::size_t n, const edge& e, word* positive, word* negative, word* uncertain) {
+		classify_body<avx2_ops>(in, begin, n, e, positive, negative, uncertain);
+	}
+
+	std::size_t farthest_soa_avx2(const soa& in, std::size_t begin, std::size_t n, const edge& e) {
+		return farthest_body<avx2_ops>(in, begin, n, e);
+	}
+
+	std::size_t farthest_aos_avx2(const aos& in, std::size_t begin, std::size_t n, const edge& e) {
+		return farthest_body<avx2_ops>(in, begin, n, e);
+	}
+}
+#pragma GCC pop_options
+
+
+#pragma GCC push_options
+#pragma GCC target("avx512f")
+namespace {
+	struct avx512_ops {
+		typedef __m512d reg;
+		typedef __mmask8 mask;
+		static const std::size_t width = 8;
+
+		static reg set1(double a) { return _mm512_set1_pd(a); }
+		static reg iota() { return _mm512_set_pd(7, 6, 5, 4, 3, 2, 1, 0); }
+		static reg load(const double* p) { return _mm512_loadu_pd(p); }
+		static void load_pairs(const double* p, reg& x, reg& y) {
+			reg first = _mm512_loadu_pd(p);
+			reg second = _mm512_loadu_pd(p + 8);
+			x = _mm512_permutex2var_pd(first, _mm512_set_epi64(14, 12, 10, 8, 6, 4, 2, 0), second);
+			y = _mm512_permutex2var_pd(first, _mm512_set_epi64(15, 13, 11, 9, 7, 5, 3, 1), second);
+		}
+		static void store(double* p, reg a) { _mm512_storeu_pd(p, a); }
+		static reg add(reg a, reg b) { return _mm512_add_pd(a, b); }
+		static reg sub(reg a, reg b) { return _mm512_sub_pd(a, b); }
+		static reg mul(reg a, reg b) { return _mm512_mul_pd(a, b); }
+		static reg abs(reg a) { return _mm512_abs_pd(a); }
+		static mask greater(reg a, reg b) { return _mm512_cmp_pd_mask(a, b, _CMP_GT_OQ); }
+		static mask equal(reg a, reg b) { return _mm512_cmp_pd_mask(a, b, _CMP_EQ_OQ); }
+		static mask both(mask a, mask b) { return a & b; }
+		static mask either(mask a, mask b) { return a | b; }
+		static reg blend(mask m, reg a, reg b) { return _mm512_mask_blend_pd(m, a, b); }
+		static word bits(mask m) { return m; }
+	};
+
+	void classify_soa_avx512(const soa& in, std::size_t begin, std::size_t n, const edge& e, word* positive, word* negative, word* uncertain) {
+		classify_body<avx512_ops>(in, begin, n, e, positive, negative, uncertain);
+	}
+
+	void classify_aos_avx512(const aos& in, std::size_t begin, std::size_t n, const edge& e, word* positive, word* negative, word* uncertain) {
+		classify_body<avx512_ops>(in, begin, n, e, positive, negative, uncertain);
+	}
+
+	std::size_t farthest_soa_avx512(const soa& in, std::size_t begin, std::size_t n, const edge& e) {
+		return farthest_body<avx512_ops>(in, begin, n, e);
+	}
+
+	std::size_t farthest_aos_avx512(const aos& in, std::size_t begin, std::size_t n, const edge& e) {
+		return farthest_body<avx512_ops>(in, begin, n, e);
+	}
+}
+#pragma GCC pop_options
+
+
+namespace {
+	void classify_soa_scalar(const soa& in, std::size_t begin, std::size_t n, const edge& e, word* positive, word* negative, word* uncertain) {
+		classify_body<scalar_ops>(in, begin, n, e, positive, negative, uncertain);
+	}
+
+	void classify_aos_scalar(const aos& in, std::size_t begin, std::size_t n, const edge& e, word* positive, word* negative, word* uncertain) {
+		classify_body<scalar_ops>(in, begin, n, e, positive, negative, uncertain);
+	}
+
+	std::size_t farthest_soa_scalar(const soa& in, std::size_t begin, std::size_t n, const edge& e) {
+		return farthest_body<scalar_ops>(in, begin, n, e);
+	}
+
+	std::size_t farthest_aos_scalar(const aos& in, std::size_t begin, std::size_t n, const edge& e) {
+		return farthest_body<scalar_ops>(in, begin, n, e);
+	}
+
+
+	template<typename Layout>
+	struct kernels {
+		void (*classify)(const Layout&, std::size_t, std::size_t, const edge&, word*, word*, word*);
+		std::size_t (*farthest)(const Layout&, std::size_t, std::size_t, const edge&);
+	};
+
+	struct kernel_table {
+		kernels<soa> separate;
+		kernels<aos> interleaved;
+	};
+
+	const kernel_table tables[] = {
+		{{classify_soa_scalar, farthest_soa_scalar}, {classify_aos_scalar, farthest_aos_scalar}},
+		{{classify_soa_sse2, farthest_soa_sse2}, {classify_aos_sse2, farthest_aos_sse2}},
+		{{classify_soa_avx2, farthest_soa_avx2}, {classify_aos_avx2, farthest_aos_avx2}},
+		{{classify_soa_avx512, farthest_soa_avx512}, {classify_aos_avx512, farthest_aos_avx512}}
+	};
+
+	//the points are classified in chunks of this many, so the bits fit on the stack
+	const std::size_t chunk_points = 512;
+	const std::size_t chunk_words = chunk_points / 64;
+
+	std::atomic<int>& active_variant() {
+		static std::atomic<int> variant(static_cast<int>(csce::orientation_kernels::variants().back()));
+		return variant;
+	}
+
+	const kernels<soa>& kernels_for(const soa&) {
+		return tables[active_variant().load(std::memory_order_relaxed)].separate;
+	}
+
+	const kernels<aos>& kernels_for(const aos&) {
+		return tables[active_variant().load(std::memory_order_relaxed)].interleaved;
+	}
+
+	edge make_edge(const csce::point<double>& a, const csce::point<double>& b) {
+		return edge{a.x, a.y, b.x, b.y};
+	}
+
+
+	/**
+	 * Classifies the points in [begin, begin + n) and settles the uncertain ones with orient2d, so
+	 * that every point ends up in exactly one of positive, negative and zero.
+	 */
+	template<typename Layout>
+	void classify_chunk(const Layout& in, std::size_t begin, std::size_t n, const edge& e, word* positive, word* negative, word* zero) {
+		for(std::size_t x=0; x<chunk_words; x++){
+			positive[x] = negative[x] = zero[x] = 0;
+		}
+		word uncertain[chunk_words] = {};
+		kernels_for(in).classify(in, begin, n, e, positive, negative, uncertain);
+		for(std::size_t x=0; x<chunk_words; x++){
+			for(word bits = uncertain[x]; bits != 0; bits &= bits - 1){
+				int bit = __builtin_ctzll(bits);
+				std::size_t i = begin + 64 * x + bit;
+				double det = csce::robust_predicates::orient2d(e.ax, e.ay, e.bx, e.by, in.px(i), in.py(i));
+				word* side = det > 0 ? positive : (det < 0 ? negative : zero);
+				side[x] |= word(1) << bit;
+			}
+		}
+	}
+
+
+	/**
+	 * Calls visit(begin, words) for every chunk with the bits of the points on the given side,
+	 * until it returns false.
+	 */
+	template<typename Layout, typename Visit>
+	void for_each_chunk(const Layout& in, std::size_t n, const edge& e, int side, Visit visit) {
+		word positive[chunk_words], negative[chunk_words], zero[chunk_words];
+		word* chosen = side > 0 ? positive : (side < 0 ? negative : zero);
+		for(std::size_t begin=0; begin<n; begin+=chunk_points){
+			classify_chunk(in, begin, std::min(chunk_points, n - begin), e, positive, negative, zero);
+			if(!visit(begin, chosen)){
+				return;
+			}
+		}
+	}
+
+
+	template<typename Layout>
+	std::size_t count(const Layout& in, std::size_t n, const edge& e, int side) {
+		std::size_t total = 0;
+		for_each_chunk(in, n, e, side, [&](std::size_t, const word* bits) {
+			for(std::size_t x=0; x<chunk_words; x++){
+				total += __builtin_popcountll(bits[x]);
+			}
+			return true;
+		});
+		return total;
+	}
+
+
+	/**
+	 * Sets the bits of the points on the given side, or of the points that are not on it if invert is set.
+	 */
+	template<typename Layout>
+	void mark(const Layout& in, std::size_t n, const edge& e, int side, bool invert, word* output) {
+		for_each_chunk(in, n, e, side, [&](std::size_t begin, const word* bits) {
+			for(std::size_t x=0; x<chunk_words && begin + 64 * x < n; x++){
+				std::size_t remaining = n - (begin + 64 * x);
+				word valid = remaining >= 64 ? ~word(0) : (word(1) << remaining) - 1;
+				output[begin / 64 + x] |= (invert ? ~bits[x] : bits[x]) & valid;
+			}
+			return true;
+		});
+	}
+
+
+	template<typename Layout>
+	std::size_t find(const Layout& in, std::size_t n, const edge& e, int side) {
+		std::size_t found = n;
+		for_each_chunk(in, n, e, side, [&](std::size_t begin, const word* bits) {
+			for(std::size_t x=0; x<chunk_words; x++){
+				if(bits[x] != 0){
+					found = begin + 64 * x + __builtin_ctzll(bits[x]);
+					return false;
+				}
+			}
+			return true;
+		});
+		return found;
+	}
+}
+
+
+bool csce::orientation_kernels::supported(isa variant) {
+	__builtin_cpu_init();
+	switch(variant){
+		case isa::scalar:
+			return true;
+		case isa::sse2:
+			return __builtin_cpu_supports("sse2");
+		case isa::avx2:
+			return __builtin_cpu_supports("avx2");
+		case isa::avx512:
+			return __builtin_cpu_supports("avx512f");
+	}
+	return false;
+}
+
+std::vector<csce::orientation_kernels::isa> csce::orientation_kernels::variants() {
+	std::vector<isa> output;
+	for(isa variant : {isa::scalar, isa::sse2, isa::avx2, isa::avx512}){
+		if(csce::orientation_kernels::supported(variant)){
+			output.push_back(variant);
+		}
+	}
+	return output;
+}
+
+std::string csce::orientation_kernels::name(isa variant) {
+	switch(variant){
+		case isa::scalar:
+			return "scalar";
+		case isa::sse2:
+			return "SSE2";
+		case isa::avx2:
+			return "AVX2";
+		case isa::avx512:
+			return "AVX-512";
+	}
+	return "unknown";
+}
+
+csce::orientation_kernels::isa csce::orientation_kernels::active() {
+	return static_cast<isa>(active_variant().load());
+}
+
+void csce::orientation_kernels::select(isa variant) {
+	if(!csce::orientation_kernels::supported(variant)){
+		throw "The processor does not support this orientation kernel variant!";
+	}
+	active_variant().store(static_cast<int>(variant));
+}
+
+std::size_t csce::orientation_kernels::count(const double* x, const double* y, std::size_t n, const csce::point<double>& a, const csce::point<double>& b, int side) {
+	return ::count(soa{x, y}, n, make_edge(a, b), side);
+}
+
+std::size_t csce::orientation_kernels::count(const csce::point<double>* points, std::size_t n, const csce::point<double>& a, const csce::point<double>& b, int side) {
+	return ::count(aos{reinterpret_cast<const double*>(points)}, n, make_edge(a, b), side);
+}
+
+void csce::orientation_kernels::mark(const double* x, const double* y, std::size_t n, const csce::point<double>& a, const csce::point<double>& b, int side, std::uint64_t* bits) {
+	::mark(soa{x, y}, n, make_edge(a, b), side, false, bits);
+}
+
+void csce::orientation_kernels::mark(const csce::point<double>* points, std::size_t n, const csce::point<double>& a, const csce::point<double>& b, int side, std::uint64_t* bits) {
+	::mark(aos{reinterpret_cast<const double*>(points)}, n, make_edge(a, b), side, false, bits);
+}
+
+void csce::orientation_kernels::mark_not(const double* x, const double* y, std::size_t n, const csce::point<double>& a, const csce::point<double>& b, int side, std::uint64_t* bits) {
+	::mark(soa{x, y}, n, make_edge(a, b), side, true, bits);
+}
+
+void csce::orientation_kernels::mark_not(const csce::point<double>* points, std::size_t n, const csce::point<double>& a, const csce::point<double>& b, int side, std::uint64_t* bits) {
+	::mark(aos{reinterpret_cast<const double*>(points)}, n, make_edge(a, b), side, true, bits);
+}
+
+std::size_t csce::orientation_kernels::find(const double* x, const double* y, std::size_t n, const csce::point<double>& a, const csce::point<double>& b, int side) {
+	return ::find(soa{x, y}, n, make_edge(a, b), side);
+}
+
+std::size_t csce::orientation_kernels::find(const csce::point<double>* points, std::size_t n, const csce::point<double>& a, const csce::point<double>& b, int side) {
+	return ::find(aos{reinterpret_cast<const double*>(points)}, n, make_edge(a, b), side);
+}
+
+std::size_t csce::orientation_kernels::farthest(const double* x, const double* y, std::size_t n, const csce::point<double>& a, const csce::point<double>& b) {
+	soa in{x, y};
+	return kernels_for(in).farthest(in, 0, n, make_edge(a, b));
+}
+
+std::size_t csce::orientation_kernels::farthest(const csce::point<double>* points, std::size_t n, const csce::point<double>& a, const csce::point<double>& b) {
+	aos in{&points->x};
+	return kernels_for(in).farthest(in, 0, n, make_edge(a, b));
+}
@@ -0,0 +1,214 @@
+#ifndef orientation_kernels_hpp
+#define orientation_kernels_hpp
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "point.hpp"
+#include "orientation.hpp"
+
+namespace csce {
+	/**
+	 * Kernels that test many points against one directed edge a->b at a time, for the hot loops
+	 * of the algorithms. The double kernels come in scalar, SSE2, AVX2 and AVX-512 variants, and
+	 * the best one the processor supports is chosen the first time a kernel runs. They work on
+	 * both separate x[] and y[] arrays and on arrays of points (x and y interleaved).
+	 *
+	 * side is +1 for points to the left of a->b (a counterclockwise turn), -1 for points to the
+	 * right of it and 0 for points on its line. Sides are exact: every lane is computed with the
+	 * fast path of robust_predicates::orient2d, and the few lanes that are too close to the line
+	 * for its error bound are recomputed one at a time with orient2d itself.
+	 *
+	 * For other coordinate types the same functions are plain loops over orientation::cross.
+	 */
+	namespace orientation_kernels {
+		enum class isa { scalar, sse2, avx2, avx512 };
+
+		/**
+		 * Whether the processor (and the operating system) supports the instruction set, from CPUID.
+		 */
+		bool supported(isa variant);
+
+		/**
+		 * The supported instruction sets, slowest first.
+		 */
+		std::vector<isa> variants();
+
+		std::string name(isa variant);
+
+		/**
+		 * The variant the kernels use, which is the fastest supported one unless select was called.
+		 */
+		isa active();
+
+		/**
+		 * Makes the kernels use the given variant, which must be supported. This is meant for
+		 * benchmarks and tests, and should not be called while kernels run on other threads.
+		 */
+		void select(isa variant);
+
+
+		/**
+		 * The number of points on the given side of a->b.
+		 */
+		std::size_t count(const double* x, const double* y, std::size_t n, const csce::point<double>& a, const csce::point<double>& b, int side);
+		std::size_t count(const csce::point<double>* points, std::size_t n, const csce::point<double>& a, const csce::point<double>& b, int side);
+
+		/**
+		 * Sets bit (i % 64) of bits[i / 64] for every point i on the given side of a->b. Other bits
+		 * are left as they are, so masks of several edges can be combined into the same bits.
+		 */
+		void mark(const double* x, const double* y, std::size_t n, const csce::point<double>& a, const csce::point<double>& b, int side, std::uint64_t* bits);
+		void mark(const csce::point<double>* points, std::size_t n, const csce::point<double>& a, const csce::point<double>& b, int side, std::uint64_t* bits);
+
+		/**
+		 * Like mark, for every point that is not on the given side of a->b.
+		 */
+		void mark_not(const double* x, const double* y, std::size_t n, const csce::point<double>& a, const csce::point<double>& b, int side, std::uint64_t* bits);
+		void mark_not(const csce::point<double>* points, std::size_t n, const csce::point<double>& a, const csce::point<double>& b, int side, std::uint64_t* bits);
+
+		/**
+		 * The index of the first point on the given side of a->b, or n if there is none.
+		 */
+		std::size_t find(const double* x, const double* y, std::size_t n, const csce::point<double>& a, const csce::point<double>& b, int side);
+		std::size_t find(const csce::point<double>* points, std::size_t n, const csce::point<double>& a, const csce::point<double>& b, int side);
+
+		/**
+		 * The index of the point with the most negative signed area (cross product) against a->b,
+		 * which is the farthest point to the right of it, or n if n is 0. Ties go to the point
+		 * farthest along a->b, and then to the first one. Areas are compared as they are rounded
+		 * by the fast path of orient2d.
+		 */
+		std::size_t farthest(const double* x, const double* y, std::size_t n, const csce::point<double>& a, const csce::point<double>& b);
+		std::size_t farthest(const csce::point<double>* points, std::size_t n, const csce::point<double>& a, const csce::point<double>& b);
+
+
+		template<typename T>
+		std::size_t count(const csce::point<T>* points, std::size_t n, const csce::point<T>& a, const csce::point<T>& b, int side) {
+			std::size_t total = 0;
+			for(std::size_t x=0; x<n; x++){
+				total += (csce::orientation::turn(a, b, points[x]) == side);
+			}
+			return total;
+		}
+
+
+		template<typename T>
+		void mark(const csce::point<T>* points, std::size_t n, const csce::point<T>& a, const csce::point<T>& b, int side, std::uint64_t* bits) {
+			for(std::size_t x=0; x<n; x++){
+				if(csce::orientation::turn(a, b, points[x]) == side){
+					bits[x / 64] |= std::uint64_t(1) << (x % 64);
+				}
+			}
+		}
+
+
+		template<typename T>
+		void mark_not(const csce::point<T>* points, std::size_t n, const csce::point<T>& a, const csce::point<T>& b, int side, std::uint64_t* bits) {
+			for(std::size_t x=0; x<n; x++){
+				if(csce::orientation::turn(a, b, points[x]) != side){
+					bits[x / 64] |= std::uint64_t(1) << (x % 64);
+				}
+			}
+		}
+
+
+		template<typename T>
+		std::size_t find(const csce::point<T>* points, std::size_t n, const csce::point<T>& a, const csce::point<T>& b, int side) {
+			for(std::size_t x=0; x<n; x++){
+				if(csce::orientation::turn(a, b, points[x]) == side){
+					return x;
+				}
+			}
+			return n;
+		}
+
+
+		template<typename T>
+		std::size_t farthest(const csce::point<T>* points, std::size_t n, const csce::point<T>& a, const csce::point<T>& b) {
+			typedef typename csce::orientation::wide<T>::type W;
+			if(n == 0){
+				return n;
+			}
+			std::size_t best = 0;
+			W best_area = csce::orientation::cross(a, b, points[0]);
+			W best_along = csce::orientation::dot(a, b, points[0]);
+			for(std::size_t x=1; x<n; x++){
+				W area = csce::orientation::cross(a, b, points[x]);
+				if(area < best_area || (area == best_area && csce::orientation::dot(a, b, points[x]) > best_along)){
+					best = x;
+					best_area = area;
+					best_along = csce::orientation::dot(a, b, points[x]);
+				}
+			}
+			return best;
+		}
+
+
+		/**
+		 * The kernels for separate x[] and y[] arrays of other coordinate types, which go through the points one at a time.
+		 */
+		template<typename T>
+		std::size_t count(const T* x, const T* y, std::size_t n, const csce::point<T>& a, const csce::point<T>& b, int side) {
+			std::size_t total = 0;
+			for(std::size_t i=0; i<n; i++){
+				total += (csce::orientation::turn(a, b, csce::point<T>(x[i], y[i])) == side);
+			}
+			return total;
+		}
+
+
+		template<typename T>
+		void mark(const T* x, const T* y, std::size_t n, const csce::point<T>& a, const csce::point<T>& b, int side, std::uint64_t* bits) {
+			for(std::size_t i=0; i<n; i++){
+				if(csce::orientation::turn(a, b, csce::point<T>(x[i], y[i])) == side){
+					bits[i / 64] |= std::uint64_t(1) << (i % 64);
+				}
+			}
+		}
+
+
+		template<typename T>
+		void mark_not(const T* x, const T* y, std::size_t n, const csce::point<T>& a, const csce::point<T>& b, int side, std::uint64_t* bits) {
+			for(std::size_t i=0; i<n; i++){
+				if(csce::orientation::turn(a, b, csce::point<T>(x[i], y[i])) != side){
+					bits[i / 64] |= std::uint64_t(1) << (i % 64);
+				}
+			}
+		}
+
+
+		template<typename T>
+		std::size_t find(const T* x, const T* y, std::size_t n, const csce::point<T>& a, const csce::point<T>& b, int side) {
+			for(std::size_t i=0; i<n; i++){
+				if(csce::orientation::turn(a, b, csce::point<T>(x[i], y[i])) == side){
+					return i;
+				}
+			}
+			return n;
+		}
+
+
+		template<typename T>
+		std::size_t farthest(const T* x, const T* y, std::size_t n, const csce::point<T>& a, const csce::point<T>& b) {
+			typedef typename csce::orientation::wide<T>::type W;
+			std::size_t best = n;
+			W best_area = 0, best_along = 0;
+			for(std::size_t i=0; i<n; i++){
+				csce::point<T> p(x[i], y[i]);
+				W area = csce::orientation::cross(a, b, p);
+				W along = csce::orientation::dot(a, b, p);
+				if(best == n || area < best_area || (area == best_area && along > best_along)){
+					best = i;
+					best_area = area;
+					best_along = along;
+				}
+			}
+			return best;
+		}
+	}
+}
+
+#endif /* orientation_kernels_hpp */
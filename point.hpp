@@ -16,8 +16,8 @@ namespace csce {
 		point(T _x, T _y) : x(_x), y(_y) {}
 		
 		long double distance_to(const csce::point<T>& other) const {
-			T dx = this->x - other.x;
-			T dy = this->y - other.y;
+			long double dx = static_cast<long double>(this->x) - other.x;
+			long double dy = static_cast<long double>(this->y) - other.y;
 			return std::sqrt(dx * dx + dy * dy);
 		}
 		
@@ -0,0 +1,246 @@
+#ifndef point_cloud_hpp
+#define point_cloud_hpp
+
+#include <vector>
+#include <new>
+#include <cstdlib>
+#include <algorithm>
+
+#include "point.hpp"
+
+namespace csce {
+	/**
+	 * Allocates memory aligned to Alignment bytes, so that vector loads from the start of the
+	 * memory never cross a cache line.
+	 */
+	template<typename T, std::size_t Alignment>
+	struct aligned_allocator {
+		typedef T value_type;
+
+		template<typename U>
+		struct rebind {
+			typedef aligned_allocator<U, Alignment> other;
+		};
+
+		aligned_allocator() {}
+
+		template<typename U>
+		aligned_allocator(const aligned_allocator<U, Alignment>&) {}
+
+		T* allocate(std::size_t n) {
+			void* memory = nullptr;
+			if(posix_memalign(&memory, Alignment, std::max<std::size_t>(1, n) * sizeof(T)) != 0){
+				throw std::bad_alloc();
+			}
+			return static_cast<T*>(memory);
+		}
+
+		void deallocate(T* memory, std::size_t) {
+			std::free(memory);
+		}
+
+		template<typename U>
+		bool operator==(const aligned_allocator<U, Alignment>&) const {
+			return true;
+		}
+
+		template<typename U>
+		bool operator!=(const aligned_allocator<U, Alignment>&) const {
+			return false;
+		}
+	};
+
+
+	template<typename T>
+	class point_cloud;
+
+
+	/**
+	 * A view of a range of a point_cloud that does not copy the coordinates. It stays valid as long
+	 * as the cloud is neither resized nor destroyed.
+	 */
+	template<typename T>
+	class point_cloud_view {
+	public:
+		point_cloud_view() {}
+		point_cloud_view(const T* _x, const T* _y, std::size_t _count) : x_values(_x), y_values(_y), count(_count) {}
+		point_cloud_view(const csce::point_cloud<T>& cloud) : point_cloud_view(cloud.x(), cloud.y(), cloud.size()) {}
+
+		const T* x() const {
+			return this->x_values;
+		}
+
+		const T* y() const {
+			return this->y_values;
+		}
+
+		std::size_t size() const {
+			return this->count;
+		}
+
+		bool empty() const {
+			return this->count == 0;
+		}
+
+		csce::point<T> operator[](std::size_t i) const {
+			return csce::point<T>(this->x_values[i], this->y_values[i]);
+		}
+
+		/**
+		 * The points in [begin, end) of this view.
+		 */
+		point_cloud_view<T> view(std::size_t begin, std::size_t end) const {
+			return point_cloud_view<T>(this->x_values + begin, this->y_values + begin, end - begin);
+		}
+
+		std::vector<csce::point<T>> to_vector() const {
+			std::vector<csce::point<T>> output;
+			output.reserve(this->count);
+			for(std::size_t i=0; i<this->count; i++){
+				output.push_back((*this)[i]);
+			}
+			return output;
+		}
+
+	private:
+		const T* x_values = nullptr;
+		const T* y_values = nullptr;
+		std::size_t count = 0;
+	};
+
+
+	/**
+	 * Points stored as separate x and y arrays (structure of arrays) instead of a vector of
+	 * points, so that kernels can load several coordinates with one vector instruction. Both
+	 * arrays start on a 64-byte boundary.
+	 *
+	 * The arrays can be padded to a multiple of a SIMD width (in points), so that whole vectors
+	 * can be read past the last point. The padding repeats the last point, which does not change
+	 * a hull, but it is not part of size() or of any view.
+	 */
+	template<typename T>
+	class point_cloud {
+	public:
+		static const std::size_t alignment = 64;
+
+		explicit point_cloud(std::size_t _padding = 1) : padding(std::max<std::size_t>(1, _padding)) {}
+
+		point_cloud(const std::vector<csce::point<T>>& points, std::size_t _padding = 1) : point_cloud(_padding) {
+			this->reserve(points.size());
+			for(auto& p : points){
+				this->x_values.push_back(p.x);
+				this->y_values.push_back(p.y);
+			}
+			this->count = points.size();
+			this->pad();
+		}
+
+		const T* x() const {
+			return this->x_values.data();
+		}
+
+		const T* y() const {
+			return this->y_values.data();
+		}
+
+		T* x() {
+			return this->x_values.data();
+		}
+
+		T* y() {
+			return this->y_values.data();
+		}
+
+		std::size_t size() const {
+			return this->count;
+		}
+
+		bool empty() const {
+			return this->count == 0;
+		}
+
+		/**
+		 * The length of the arrays, which is size() rounded up to the padding.
+		 */
+		std::size_t padded_size() const {
+			return this->x_values.size();
+		}
+
+		csce::point<T> operator[](std::size_t i) const {
+			return csce::point<T>(this->x_values[i], this->y_values[i]);
+		}
+
+		void set(std::size_t i, const csce::point<T>& p) {
+			this->x_values[i] = p.x;
+			this->y_values[i] = p.y;
+			if(i + 1 == this->count){
+				this->pad();
+			}
+		}
+
+		void reserve(std::size_t n) {
+			this->x_values.reserve(this->round_up(n));
+			this->y_values.reserve(this->round_up(n));
+		}
+
+		/**
+		 * Changes the number of points. New points are (0, 0), and the padding is only filled again
+		 * by set() on the last point, so that the arrays can be written through x() and y() first.
+		 */
+		void resize(std::size_t n) {
+			this->x_values.resize(this->round_up(n));
+			this->y_values.resize(this->round_up(n));
+			this->count = n;
+		}
+
+		void push_back(const csce::point<T>& p) {
+			this->x_values.resize(this->count);
+			this->y_values.resize(this->count);
+			this->x_values.push_back(p.x);
+			this->y_values.push_back(p.y);
+			this->count++;
+			this->pad();
+		}
+
+		void clear() {
+			this->x_values.clear();
+			this->y_values.clear();
+			this->count = 0;
+		}
+
+		/**
+		 * The points in [begin, end), without copying them.
+		 */
+		csce::point_cloud_view<T> view(std::size_t begin, std::size_t end) const {
+			return csce::point_cloud_view<T>(*this).view(begin, end);
+		}
+
+		std::vector<csce::point<T>> to_vector() const {
+			return csce::point_cloud_view<T>(*this).to_vector();
+		}
+
+	private:
+		std::vector<T, csce::aligned_allocator<T, alignment>> x_values;
+		std::vector<T, csce::aligned_allocator<T, alignment>> y_values;
+		std::size_t count = 0;
+		std::size_t padding = 1;
+
+		std::size_t round_up(std::size_t n) const {
+			return (n + this->padding - 1) / this->padding * this->padding;
+		}
+
+		void pad() {
+			if(this->count == 0){
+				return;
+			}
+			T last_x = this->x_values[this->count - 1];
+			T last_y = this->y_values[this->count - 1];
+			this->x_values.resize(this->round_up(this->count));
+			this->y_values.resize(this->round_up(this->count));
+			std::fill(this->x_values.begin() + this->count, this->x_values.end(), last_x);
+			std::fill(this->y_values.begin() + this->count, this->y_values.end(), last_y);
+		}
+	};
+}
+
+#endif /* point_cloud_hpp */
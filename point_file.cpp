@@ -0,0 +1,353 @@
+#include "point_file.hpp"
+
+#include <fstream>
+#include <algorithm>
+
+#include "scratch_arena.hpp"
+#include "radix_sort.hpp"
+#include <cerrno>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+namespace {
+	const char magic[8] = { 'C', 'S', 'C', 'E', 'P', 'T', 'S', '\0' };
+	//reads as another number on a machine with the other byte order
+	const std::uint32_t byte_order_mark = 0x01020304;
+	const std::size_t page_size = 4096;
+	//a compressed block is 256 KB decoded, which a thread decodes in its cache
+	const std::size_t compressed_block = std::size_t(1) << 14;
+	//the longest varint of a 64-bit number
+	const std::size_t longest_varint = 10;
+
+	std::size_t align_up(std::size_t value, std::size_t alignment) {
+		return (value + alignment - 1) & ~(alignment - 1);
+	}
+
+	static_assert(sizeof(csce::point_file::header) == csce::point_file::alignment, "the header must fill exactly one aligned block");
+
+	std::uint64_t read_word(const char* data) {
+		std::uint64_t value;
+		std::memcpy(&value, data, sizeof(value));
+		return value;
+	}
+
+	/**
+	 * Spreads the 32 bits of value out to the even bits of the result.
+	 */
+	std::uint64_t spread(std::uint64_t value) {
+		value &= 0xFFFFFFFFULL;
+		value = (value | (value << 16)) & 0x0000FFFF0000FFFFULL;
+		value = (value | (value << 8)) & 0x00FF00FF00FF00FFULL;
+		value = (value | (value << 4)) & 0x0F0F0F0F0F0F0F0FULL;
+		value = (value | (value << 2)) & 0x3333333333333333ULL;
+		value = (value | (value << 1)) & 0x5555555555555555ULL;
+		return value;
+	}
+
+	/**
+	 * Gathers the even bits of value back into 32 bits, which undoes spread.
+	 */
+	std::uint64_t gather(std::uint64_t value) {
+		value &= 0x5555555555555555ULL;
+		value = (value | (value >> 1)) & 0x3333333333333333ULL;
+		value = (value | (value >> 2)) & 0x0F0F0F0F0F0F0F0FULL;
+		value = (value | (value >> 4)) & 0x00FF00FF00FF00FFULL;
+		value = (value | (value >> 8)) & 0x0000FFFF0000FFFFULL;
+		value = (value | (value >> 16)) & 0x00000000FFFFFFFFULL;
+		return value;
+	}
+}
+
+const std::uint32_t csce::point_file::current_version;
+const std::size_t csce::point_file::alignment;
+const std::size_t csce::point_file::minimum_chunk;
+const std::size_t csce::point_file::write_buffer;
+
+csce::point_file::point_file(const std::string& path) {
+	int descriptor = open(path.c_str(), O_RDONLY);
+	if(descriptor < 0){
+		throw "point_file: could not open the file";
+	}
+
+	struct stat status;
+	if(fstat(descriptor, &status) != 0 || static_cast<std::size_t>(status.st_size) < sizeof(header)){
+		close(descriptor);
+		throw "point_file: the file is too short to be a point file";
+	}
+	this->length = static_cast<std::size_t>(status.st_size);
+
+	void* memory = mmap(nullptr, this->length, PROT_READ, MAP_PRIVATE, descriptor, 0);
+	close(descriptor); //the mapping keeps the file open
+	if(memory == MAP_FAILED){
+		throw "point_file: could not map the file";
+	}
+	this->mapping = static_cast<const char*>(memory);
+	std::memcpy(&this->info, this->mapping, sizeof(header));
+
+	const char* error = nullptr;
+	if(std::memcmp(this->info.magic, magic, sizeof(magic)) != 0){
+		error = "point_file: the file is not a point file";
+	} else if(this->info.version == 0 || this->info.version > current_version){
+		error = "point_file: the file was written by a newer version";
+	} else if(this->info.byte_order != byte_order_mark){
+		error = "point_file: the file was written on a machine with another byte order";
+	} else if(this->info.type != int64 && this->info.type != float64){
+		error = "point_file: the file has an unknown coordinate type";
+	} else if(this->info.layout != interleaved && this->info.layout != separate && this->info.layout != compressed){
+		error = "point_file: the file has an unknown layout";
+	} else if(this->info.layout == compressed){
+		error = this->read_block_table();
+	} else if(this->info.count > (this->length - sizeof(header)) / 16 || file_size(this->layout(), this->size()) > this->length){
+		error = "point_file: the file is shorter than its header says";
+	}
+	if(error != nullptr){
+		munmap(const_cast<char*>(this->mapping), this->length);
+		throw error;
+	}
+
+#ifdef MADV_WILLNEED
+	madvise(const_cast<char*>(this->mapping), this->length, MADV_WILLNEED);
+#endif
+}
+
+csce::point_file::~point_file() {
+	munmap(const_cast<char*>(this->mapping), this->length);
+}
+
+bool csce::point_file::detect(const std::string& path) {
+	std::ifstream file(path, std::ios::in | std::ios::binary);
+	char start[sizeof(magic)] = {};
+	return file.read(start, sizeof(start)) && std::memcmp(start, magic, sizeof(magic)) == 0;
+}
+
+bool csce::point_file::binary_path(const std::string& path) {
+	const std::string extension = ".bin";
+	return path.size() > extension.size() && path.compare(path.size() - extension.size(), extension.size(), extension) == 0;
+}
+
+bool csce::point_file::compressed_path(const std::string& path) {
+	const std::string extension = ".binz";
+	return path.size() > extension.size() && path.compare(path.size() - extension.size(), extension.size(), extension) == 0;
+}
+
+std::size_t csce::point_file::block_size() const {
+	return this->points_per_block;
+}
+
+std::size_t csce::point_file::block_count() const {
+	return this->blocks;
+}
+
+const char* csce::point_file::read_block_table() {
+	if(this->info.type != int64){
+		return "point_file: the file has compressed coordinates that are not integers";
+	}
+	if(this->length < sizeof(header) + 16){
+		return "point_file: the file is shorter than its header says";
+	}
+	this->points_per_block = read_word(this->mapping + sizeof(header));
+	this->blocks = read_word(this->mapping + sizeof(header) + 8);
+	this->block_table = this->mapping + sizeof(header) + 16;
+	if(this->points_per_block == 0 || this->blocks != (this->info.count + this->points_per_block - 1) / this->points_per_block){
+		return "point_file: the file has a broken block table";
+	}
+	if(this->blocks >= (this->length - sizeof(header) - 16) / 8){
+		return "point_file: the file is shorter than its header says";
+	}
+
+	//every block starts after the table and ends where the next one starts, within the file
+	std::size_t previous = sizeof(header) + 16 + 8 * (this->blocks + 1);
+	for(std::size_t x=0; x<=this->blocks; x++){
+		std::size_t start = read_word(this->block_table + 8 * x);
+		if(start < previous || start > this->length){
+			return "point_file: the file has a broken block table";
+		}
+		previous = start;
+	}
+	return nullptr;
+}
+
+std::size_t csce::point_file::decode(std::size_t block, csce::point<long long>* output) const {
+	const unsigned char* next = reinterpret_cast<const unsigned char*>(this->mapping + read_word(this->block_table + 8 * block));
+	const unsigned char* end = reinterpret_cast<const unsigned char*>(this->mapping + read_word(this->block_table + 8 * (block + 1)));
+	std::size_t count = std::min(this->points_per_block, this->size() - block * this->points_per_block);
+	std::uint64_t low_x = read_word(reinterpret_cast<const char*>(this->info.bounds));
+	std::uint64_t low_y = read_word(reinterpret_cast<const char*>(this->info.bounds) + 8);
+
+	std::uint64_t code = 0;
+	for(std::size_t x=0; x<count; x++){
+		//a damaged block reads as zero differences instead of past its end
+		std::uint64_t difference = 0;
+		for(int shift=0; next < end && shift < 64; shift+=7){
+			difference |= static_cast<std::uint64_t>(*next & 0x7F) << shift;
+			if((*next++ & 0x80) == 0){
+				break;
+			}
+		}
+		code += difference;
+		output[x] = csce::point<long long>(static_cast<long long>(low_x + gather(code)), static_cast<long long>(low_y + gather(code >> 1)));
+	}
+	return count;
+}
+
+void csce::point_file::write_compressed(const csce::point<long long>* points, std::size_t count, const std::string& path, csce::executor& pool) {
+	if(count > 0xFFFFFFFFULL){
+		throw "point_file::write: too many points to compress";
+	}
+
+	//the bounding box, whose ranges have to fit in the 32 bits of each half of a Morton code
+	std::vector<csce::point<long long>> lows(pool.chunk_count(count, minimum_chunk), count > 0 ? points[0] : csce::point<long long>());
+	std::vector<csce::point<long long>> highs(lows);
+	pool.parallel_for(count, minimum_chunk, [&](std::size_t chunk, std::size_t begin, std::size_t end) {
+		for(std::size_t x=begin; x<end; x++){
+			lows[chunk].x = std::min(lows[chunk].x, points[x].x);
+			lows[chunk].y = std::min(lows[chunk].y, points[x].y);
+			highs[chunk].x = std::max(highs[chunk].x, points[x].x);
+			highs[chunk].y = std::max(highs[chunk].y, points[x].y);
+		}
+	});
+	long long box[4] = { lows[0].x, lows[0].y, highs[0].x, highs[0].y };
+	for(std::size_t x=1; x<lows.size(); x++){
+		box[0] = std::min(box[0], lows[x].x);
+		box[1] = std::min(box[1], lows[x].y);
+		box[2] = std::max(box[2], highs[x].x);
+		box[3] = std::max(box[3], highs[x].y);
+	}
+	std::uint64_t low_x = static_cast<std::uint64_t>(box[0]);
+	std::uint64_t low_y = static_cast<std::uint64_t>(box[1]);
+	if(static_cast<std::uint64_t>(box[2]) - low_x > 0xFFFFFFFFULL || static_cast<std::uint64_t>(box[3]) - low_y > 0xFFFFFFFFULL){
+		throw "point_file::write: the coordinates span more than 2^32 values, which cannot be compressed";
+	}
+
+	csce::scratch_arena arena;
+	csce::scratch_arena::scope scope(arena);
+	csce::scratch_vector<std::uint64_t> codes(count, 0, csce::arena_allocator<std::uint64_t>(&arena));
+	csce::scratch_vector<std::uint32_t> order(count, 0, csce::arena_allocator<std::uint32_t>(&arena));
+	pool.parallel_for(count, minimum_chunk, [&](std::size_t, std::size_t begin, std::size_t end) {
+		for(std::size_t x=begin; x<end; x++){
+			codes[x] = spread(static_cast<std::uint64_t>(points[x].x) - low_x) | (spread(static_cast<std::uint64_t>(points[x].y) - low_y) << 1);
+		}
+	});
+	csce::radix_sort::sort(codes, order, pool);
+
+	//every block is encoded on its own, into a buffer that is large enough for the longest varints
+	std::size_t blocks = (count + compressed_block - 1) / compressed_block;
+	std::vector<std::vector<unsigned char>> encoded(blocks);
+	pool.parallel_for(blocks, 1, [&](std::size_t, std::size_t begin, std::size_t end) {
+		for(std::size_t block=begin; block<end; block++){
+			std::size_t first = block * compressed_block;
+			std::size_t last = std::min(count, first + compressed_block);
+			std::vector<unsigned char>& bytes = encoded[block];
+			bytes.resize((last - first) * longest_varint);
+			std::size_t size = 0;
+			std::uint64_t previous = 0;
+			for(std::size_t x=first; x<last; x++){
+				std::uint64_t difference = codes[x] - previous;
+				previous = codes[x];
+				while(difference >= 0x80){
+					bytes[size++] = static_cast<unsigned char>(difference | 0x80);
+					difference >>= 7;
+				}
+				bytes[size++] = static_cast<unsigned char>(difference);
+			}
+			bytes.resize(size);
+		}
+	});
+
+	std::vector<std::uint64_t> table(blocks + 3);
+	table[0] = compressed_block;
+	table[1] = blocks;
+	table[2] = sizeof(header) + 8 * table.size();
+	for(std::size_t block=0; block<blocks; block++){
+		table[block + 3] = table[block + 2] + encoded[block].size();
+	}
+
+	header info = make_header(int64, compressed, count);
+	std::memcpy(info.bounds, box, sizeof(box));
+	int descriptor = create(path, info, table.back());
+
+	bool failed = !write_at(descriptor, table.data(), 8 * table.size(), sizeof(header));
+	std::vector<char> failed_blocks(blocks, 0);
+	pool.parallel_for(blocks, 1, [&](std::size_t, std::size_t begin, std::size_t end) {
+		for(std::size_t block=begin; block<end; block++){
+			failed_blocks[block] = !write_at(descriptor, encoded[block].data(), encoded[block].size(), table[block + 2]);
+		}
+	});
+
+	bool closed = finish(descriptor);
+	if(failed || !closed || std::find(failed_blocks.begin(), failed_blocks.end(), 1) != failed_blocks.end()){
+		throw "point_file::write: could not write the points";
+	}
+}
+
+void csce::point_file::prefault(csce::executor& pool) const {
+	std::size_t pages = (this->length + page_size - 1) / page_size;
+	const volatile char* memory = this->mapping;
+	pool.parallel_for(pages, minimum_chunk / 16, [&](std::size_t, std::size_t begin, std::size_t end) {
+		for(std::size_t x=begin; x<end; x++){
+			char value = memory[x * page_size];
+			(void)value;
+		}
+	});
+}
+
+std::size_t csce::point_file::offset(layout_type layout, std::size_t count, std::size_t which) {
+	if(layout == interleaved || which == 0){
+		return sizeof(header);
+	}
+	return sizeof(header) + align_up(count * 8, alignment);
+}
+
+std::size_t csce::point_file::file_size(layout_type layout, std::size_t count) {
+	if(layout == interleaved){
+		return sizeof(header) + count * 16;
+	}
+	return offset(layout, count, 1) + count * 8;
+}
+
+csce::point_file::header csce::point_file::make_header(std::uint32_t type, layout_type layout, std::size_t count) {
+	header info;
+	std::memset(&info, 0, sizeof(info));
+	std::memcpy(info.magic, magic, sizeof(magic));
+	info.version = current_version;
+	info.byte_order = byte_order_mark;
+	info.type = type;
+	info.layout = layout;
+	info.count = count;
+	return info;
+}
+
+int csce::point_file::create(const std::string& path, const header& info, std::size_t size) {
+	int descriptor = open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+	if(descriptor < 0){
+		throw "point_file::write: could not create the file";
+	}
+	if(ftruncate(descriptor, static_cast<off_t>(size)) != 0 || !write_at(descriptor, &info, sizeof(info), 0)){
+		close(descriptor);
+		throw "point_file::write: could not write the header";
+	}
+	return descriptor;
+}
+
+bool csce::point_file::write_at(int descriptor, const void* data, std::size_t bytes, std::size_t offset) {
+	const char* next = static_cast<const char*>(data);
+	while(bytes > 0){
+		ssize_t written = pwrite(descriptor, next, bytes, static_cast<off_t>(offset));
+		if(written < 0 && errno == EINTR){
+			continue;
+		}
+		if(written <= 0){
+			return false;
+		}
+		next += written;
+		offset += static_cast<std::size_t>(written);
+		bytes -= static_cast<std::size_t>(written);
+	}
+	return true;
+}
+
+bool csce::point_file::finish(int descriptor) {
+	return close(descriptor) == 0;
+}
@@ -0,0 +1,445 @@
+#ifndef point_file_hpp
+#define point_file_hpp
+
+#include <vector>
+#include <string>
+#include <cstdint>
+#include <cstring>
+#include <algorithm>
+#include <type_traits>
+
+#include "point.hpp"
+#include "point_span.hpp"
+#include "point_cloud.hpp"
+#include "executor.hpp"
+
+namespace csce {
+	/**
+	 * A binary file of points that is memory-mapped instead of parsed. The file starts with a
+	 * 64-byte header (see header) that is followed by the coordinates, either as x, y pairs
+	 * (interleaved, the memory layout of a vector of points) or as all of the x coordinates followed
+	 * by all of the y coordinates (separate, the layout of a point_cloud). Every array starts on a
+	 * 64-byte boundary. Coordinates are 64-bit integers or doubles in the byte order of the machine
+	 * that wrote the file, which the header records so that a file from another machine is refused
+	 * instead of misread.
+	 *
+	 * If the file's coordinates have the type of the points and are interleaved, span() hands the
+	 * mapped memory to the algorithms without copying it; otherwise to_vector() converts it on the
+	 * threads of an executor.
+	 *
+	 * Integer points whose x and y ranges each fit in 32 bits can also be compressed. They are
+	 * sorted by their Morton code (the bits of x - min x and y - min y interleaved), which keeps
+	 * points that are close in the plane close in the file, and every block of block_size()
+	 * points stores the differences between consecutive codes as varints (7 bits per byte, with
+	 * the top bit set on all but the last byte). A block starts again from 0, so any block can be
+	 * decoded on its own: to_vector() decodes them all at once, and copy() only the ones it needs.
+	 * The points come back in Morton order, not in the order they were written.
+	 */
+	class point_file {
+	public:
+		enum coordinate_type : std::uint32_t {
+			int64 = 1,
+			float64 = 2
+		};
+
+		enum layout_type : std::uint32_t {
+			interleaved = 0,
+			separate = 1,
+			compressed = 2
+		};
+
+		struct header {
+			char magic[8];
+			std::uint32_t version;
+			std::uint32_t byte_order;
+			std::uint32_t type;
+			std::uint32_t layout;
+			std::uint64_t count;
+			//min x, min y, max x, max y, each stored as one coordinate
+			unsigned char bounds[32];
+		};
+
+		static const std::uint32_t current_version = 1;
+		static const std::size_t alignment = 64;
+
+
+		/**
+		 * Maps the file at path, and throws if it is not a point file that this version can read.
+		 */
+		explicit point_file(const std::string& path);
+		~point_file();
+
+
+		/**
+		 * Whether the file at path starts like a point file, so that -f can tell it from a text file.
+		 */
+		static bool detect(const std::string& path);
+
+
+		/**
+		 * Whether points written to path should be written as a point file, which is the case when
+		 * its extension is ".bin".
+		 */
+		static bool binary_path(const std::string& path);
+
+
+		/**
+		 * Whether points written to path should be written as a compressed point file, which is the
+		 * case when its extension is ".binz".
+		 */
+		static bool compressed_path(const std::string& path);
+
+
+		std::size_t size() const {
+			return this->info.count;
+		}
+
+		coordinate_type type() const {
+			return static_cast<coordinate_type>(this->info.type);
+		}
+
+		layout_type layout() const {
+			return static_cast<layout_type>(this->info.layout);
+		}
+
+
+		/**
+		 * The number of points in every block of a compressed file but the last.
+		 */
+		std::size_t block_size() const;
+
+
+		/**
+		 * The number of blocks of a compressed file.
+		 */
+		std::size_t block_count() const;
+
+
+		/**
+		 * Touches every page of the file on the threads of pool, so that the algorithms do not stop
+		 * for the page faults (and the disk reads behind them) one at a time later.
+		 */
+		void prefault(csce::executor& pool) const;
+
+
+		/**
+		 * The type of the coordinates of a point<T> in a file, or 0 if T cannot be stored.
+		 */
+		template<typename T>
+		static std::uint32_t type_of() {
+			if(std::is_integral<T>::value && std::is_signed<T>::value && sizeof(T) == 8){
+				return int64;
+			}
+			if(std::is_same<T, double>::value){
+				return float64;
+			}
+			return 0;
+		}
+
+
+		/**
+		 * Whether span<T>() can hand out the mapped points without converting them.
+		 */
+		template<typename T>
+		bool maps() const {
+			return this->info.type == type_of<T>() && this->info.layout == interleaved && sizeof(csce::point<T>) == 2 * sizeof(T);
+		}
+
+
+		/**
+		 * The first limit points of the file (all of them if limit is 0), straight from the mapping.
+		 * It stays valid as long as this file is open.
+		 */
+		template<typename T>
+		csce::point_span<T> span(std::size_t limit = 0) const {
+			if(!this->maps<T>()){
+				throw "point_file::span: the file's points are stored as another type or layout";
+			}
+			return csce::point_span<T>(reinterpret_cast<const csce::point<T>*>(this->array(0)), this->limited(limit));
+		}
+
+
+		/**
+		 * The x and y arrays of a file with separate coordinates of type T, straight from the mapping.
+		 */
+		template<typename T>
+		csce::point_cloud_view<T> view(std::size_t limit = 0) const {
+			if(this->info.type != type_of<T>() || this->info.layout != separate){
+				throw "point_file::view: the file's coordinates are stored as another type or layout";
+			}
+			return csce::point_cloud_view<T>(reinterpret_cast<const T*>(this->array(0)), reinterpret_cast<const T*>(this->array(1)), this->limited(limit));
+		}
+
+
+		/**
+		 * Point i of the file, converted to T.
+		 */
+		template<typename T>
+		csce::point<T> get(std::size_t i) const {
+			if(this->info.layout == compressed){
+				std::vector<csce::point<T>> point;
+				this->copy(i, i + 1, point);
+				return point[0];
+			}
+			if(this->info.layout == interleaved){
+				return csce::point<T>(coordinate<T>(this->array(0) + 16 * i, this->info.type), coordinate<T>(this->array(0) + 16 * i + 8, this->info.type));
+			}
+			return csce::point<T>(coordinate<T>(this->array(0) + 8 * i, this->info.type), coordinate<T>(this->array(1) + 8 * i, this->info.type));
+		}
+
+
+		/**
+		 * Copies the first limit points (all of them if limit is 0) into a vector, converting them to
+		 * T. Every thread of pool converts its own contiguous part.
+		 */
+		template<typename T>
+		std::vector<csce::point<T>> to_vector(std::size_t limit, csce::executor& pool) const {
+			std::vector<csce::point<T>> points(this->limited(limit));
+			if(this->info.layout == compressed){
+				std::size_t blocks = (points.size() + this->block_size() - 1) / this->block_size();
+				pool.parallel_for(blocks, 1, [&](std::size_t, std::size_t begin, std::size_t end) {
+					std::vector<csce::point<long long>> decoded(this->block_size());
+					for(std::size_t block=begin; block<end; block++){
+						std::size_t count = this->decode(block, decoded.data());
+						std::size_t first = block * this->block_size();
+						for(std::size_t x=0; x<count && first + x < points.size(); x++){
+							points[first + x] = csce::point<T>(static_cast<T>(decoded[x].x), static_cast<T>(decoded[x].y));
+						}
+					}
+				});
+				return points;
+			}
+			pool.parallel_for(points.size(), minimum_chunk, [&](std::size_t, std::size_t begin, std::size_t end) {
+				for(std::size_t x=begin; x<end; x++){
+					points[x] = this->get<T>(x);
+				}
+			});
+			return points;
+		}
+
+
+		/**
+		 * Appends the points in [begin, end) to output, converted to T. Of a compressed file, only
+		 * the blocks that hold them are decoded.
+		 */
+		template<typename T>
+		void copy(std::size_t begin, std::size_t end, std::vector<csce::point<T>>& output) const {
+			end = std::min(end, this->size());
+			if(begin >= end){
+				return;
+			}
+			output.reserve(output.size() + (end - begin));
+			if(this->info.layout != compressed){
+				for(std::size_t x=begin; x<end; x++){
+					output.push_back(this->get<T>(x));
+				}
+				return;
+			}
+
+			std::vector<csce::point<long long>> decoded(this->block_size());
+			for(std::size_t block=begin / this->block_size(); block * this->block_size() < end; block++){
+				std::size_t first = block * this->block_size();
+				std::size_t count = this->decode(block, decoded.data());
+				for(std::size_t x=std::max(first, begin); x<std::min(first + count, end); x++){
+					output.push_back(csce::point<T>(static_cast<T>(decoded[x - first].x), static_cast<T>(decoded[x - first].y)));
+				}
+			}
+		}
+
+
+		/**
+		 * The corner of the bounding box with the smallest coordinates.
+		 */
+		template<typename T>
+		csce::point<T> lower() const {
+			return csce::point<T>(coordinate<T>(this->info.bounds, this->info.type), coordinate<T>(this->info.bounds + 8, this->info.type));
+		}
+
+
+		/**
+		 * The corner of the bounding box with the largest coordinates.
+		 */
+		template<typename T>
+		csce::point<T> upper() const {
+			return csce::point<T>(coordinate<T>(this->info.bounds + 16, this->info.type), coordinate<T>(this->info.bounds + 24, this->info.type));
+		}
+
+
+		/**
+		 * Writes the points to path as a point file. The file is sized up front and every thread of
+		 * pool writes its own part of it with pwrite: interleaved points straight from memory,
+		 * separate coordinates through a buffer of a few thousand points, and compressed points
+		 * one encoded block at a time.
+		 */
+		template<typename T>
+		static void write(const csce::point_span<T>& points, const std::string& path, csce::executor& pool, layout_type layout = interleaved) {
+			std::uint32_t type = type_of<T>();
+			if(type == 0 || sizeof(csce::point<T>) != 2 * sizeof(T)){
+				throw "point_file::write: the coordinates are not 64-bit integers or doubles";
+			}
+			if(layout == compressed){
+				if(type != int64){
+					throw "point_file::write: only integer coordinates can be compressed";
+				}
+				std::vector<csce::point<long long>> integers;
+				if(!std::is_same<T, long long>::value){
+					integers.reserve(points.size());
+					for(auto& p : points){
+						integers.push_back(csce::point<long long>(static_cast<long long>(p.x), static_cast<long long>(p.y)));
+					}
+				}
+				write_compressed(integers.empty() ? reinterpret_cast<const csce::point<long long>*>(points.data()) : integers.data(), points.size(), path, pool);
+				return;
+			}
+
+			//the bounding box of every chunk, then of all of them
+			std::size_t n = points.size();
+			std::vector<csce::point<T>> lows(pool.chunk_count(n, minimum_chunk), n > 0 ? points[0] : csce::point<T>());
+			std::vector<csce::point<T>> highs(lows);
+			pool.parallel_for(n, minimum_chunk, [&](std::size_t chunk, std::size_t begin, std::size_t end) {
+				for(std::size_t x=begin; x<end; x++){
+					lows[chunk].x = std::min(lows[chunk].x, points[x].x);
+					lows[chunk].y = std::min(lows[chunk].y, points[x].y);
+					highs[chunk].x = std::max(highs[chunk].x, points[x].x);
+					highs[chunk].y = std::max(highs[chunk].y, points[x].y);
+				}
+			});
+			T box[4] = { lows[0].x, lows[0].y, highs[0].x, highs[0].y };
+			for(std::size_t x=1; x<lows.size(); x++){
+				box[0] = std::min(box[0], lows[x].x);
+				box[1] = std::min(box[1], lows[x].y);
+				box[2] = std::max(box[2], highs[x].x);
+				box[3] = std::max(box[3], highs[x].y);
+			}
+
+			header info = make_header(type, layout, n);
+			std::memcpy(info.bounds, box, sizeof(box));
+			int descriptor = create(path, info, file_size(layout, n));
+
+			std::vector<char> failed(pool.chunk_count(n, minimum_chunk), 0);
+			pool.parallel_for(n, minimum_chunk, [&](std::size_t chunk, std::size_t begin, std::size_t end) {
+				if(layout == interleaved){
+					failed[chunk] = !write_at(descriptor, points.data() + begin, (end - begin) * sizeof(csce::point<T>), offset(interleaved, n, 0) + begin * sizeof(csce::point<T>));
+					return;
+				}
+
+				std::vector<T> xs(std::min(end - begin, write_buffer));
+				std::vector<T> ys(xs.size());
+				for(std::size_t start=begin; start<end && !failed[chunk]; start+=write_buffer){
+					std::size_t stop = std::min(end, start + write_buffer);
+					for(std::size_t x=start; x<stop; x++){
+						xs[x - start] = points[x].x;
+						ys[x - start] = points[x].y;
+					}
+					failed[chunk] = !write_at(descriptor, xs.data(), (stop - start) * sizeof(T), offset(separate, n, 0) + start * sizeof(T));
+					failed[chunk] |= !write_at(descriptor, ys.data(), (stop - start) * sizeof(T), offset(separate, n, 1) + start * sizeof(T));
+				}
+			});
+
+			bool closed = finish(descriptor);
+			if(!closed || std::find(failed.begin(), failed.end(), 1) != failed.end()){
+				throw "point_file::write: could not write the points";
+			}
+		}
+
+
+	private:
+		//chunks smaller than this are not worth a task
+		static const std::size_t minimum_chunk = 1 << 16;
+		//the number of points that a thread gathers before every write of separate coordinates
+		static const std::size_t write_buffer = 1 << 12;
+
+		header info;
+		const char* mapping = nullptr;
+		std::size_t length = 0;
+		//the block table of a compressed file: points per block, the number of blocks, and where each block starts
+		std::size_t points_per_block = 0;
+		std::size_t blocks = 0;
+		const char* block_table = nullptr;
+
+
+		point_file(const point_file&);
+		point_file& operator=(const point_file&);
+
+
+		std::size_t limited(std::size_t limit) const {
+			return limit == 0 ? this->size() : std::min<std::size_t>(limit, this->size());
+		}
+
+
+		/**
+		 * The start of the pairs (which is 0), or of the x (0) or y (1) coordinates.
+		 */
+		const char* array(std::size_t which) const {
+			return this->mapping + offset(this->layout(), this->size(), which);
+		}
+
+
+		/**
+		 * Where array which of a file with count points starts.
+		 */
+		static std::size_t offset(layout_type layout, std::size_t count, std::size_t which);
+
+
+		/**
+		 * The size of a file with count points, which is not known in advance for compressed points.
+		 */
+		static std::size_t file_size(layout_type layout, std::size_t count);
+
+
+		static header make_header(std::uint32_t type, layout_type layout, std::size_t count);
+
+
+		/**
+		 * Creates the file at path with its final size and writes the header, and returns its descriptor.
+		 */
+		static int create(const std::string& path, const header& info, std::size_t size);
+
+
+		/**
+		 * Sorts the points by Morton code, encodes them in blocks on the threads of pool, and writes
+		 * them to path.
+		 */
+		static void write_compressed(const csce::point<long long>* points, std::size_t count, const std::string& path, csce::executor& pool);
+
+
+		/**
+		 * Reads the block table of a compressed file, and returns why it is broken, or nullptr if it is not.
+		 */
+		const char* read_block_table();
+
+
+		/**
+		 * Decodes a block of a compressed file into output, which has room for block_size() points,
+		 * and returns the number of points in the block.
+		 */
+		std::size_t decode(std::size_t block, csce::point<long long>* output) const;
+
+
+		/**
+		 * Writes bytes at offset in the file, and returns whether all of them were written.
+		 */
+		static bool write_at(int descriptor, const void* data, std::size_t bytes, std::size_t offset);
+
+
+		/**
+		 * Closes a file from create, and returns whether it was closed without an error.
+		 */
+		static bool finish(int descriptor);
+
+
+		template<typename T>
+		static T coordinate(const void* data, std::uint32_t type) {
+			if(type == int64){
+				std::int64_t value;
+				std::memcpy(&value, data, sizeof(value));
+				return static_cast<T>(value);
+			}
+			double value;
+			std::memcpy(&value, data, sizeof(value));
+			return static_cast<T>(value);
+		}
+	};
+}
+
+#endif /* point_file_hpp */
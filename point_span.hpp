@@ -0,0 +1,61 @@
+#ifndef point_span_hpp
+#define point_span_hpp
+
+#include <vector>
+#include <cstddef>
+
+#include "point.hpp"
+
+namespace csce {
+	/**
+	 * A read-only view of points that someone else owns: a vector, an array, or a memory-mapped
+	 * file. It does not copy the points, and stays valid as long as they are neither moved nor
+	 * destroyed.
+	 */
+	template<typename T>
+	class point_span {
+	public:
+		typedef const csce::point<T>* iterator;
+
+		point_span() {}
+		point_span(const csce::point<T>* _points, std::size_t _count) : points(_points), count(_count) {}
+		point_span(const std::vector<csce::point<T>>& _points) : points(_points.data()), count(_points.size()) {}
+
+		const csce::point<T>* data() const {
+			return this->points;
+		}
+
+		std::size_t size() const {
+			return this->count;
+		}
+
+		bool empty() const {
+			return this->count == 0;
+		}
+
+		const csce::point<T>& operator[](std::size_t i) const {
+			return this->points[i];
+		}
+
+		iterator begin() const {
+			return this->points;
+		}
+
+		iterator end() const {
+			return this->points + this->count;
+		}
+
+		/**
+		 * The points in [begin, end) of this span.
+		 */
+		point_span<T> subspan(std::size_t begin, std::size_t end) const {
+			return point_span<T>(this->points + begin, end - begin);
+		}
+
+	private:
+		const csce::point<T>* points = nullptr;
+		std::size_t count = 0;
+	};
+}
+
+#endif /* point_span_hpp */
@@ -5,17 +5,19 @@
 #include <string>
 #include <iostream>
 #include <utility>
+#include <cstdint>
 
 #include "convex_hull_base.hpp"
 #include "point.hpp"
 #include "line.hpp"
-#include "vector2d.hpp"
-#include "math_utility.hpp"
+#include "orientation_kernels.hpp"
 
 namespace csce {
 	template<typename T>
 	class quick_hull : public csce::convex_hull_base<T> {
 	public:
+		using csce::convex_hull_base<T>::compute_hull;
+		
 		quick_hull(int _nthreads) : csce::convex_hull_base<T>(_nthreads) {}
 		
 		std::string name() const {
@@ -23,6 +25,14 @@ namespace csce {
 		}
 
 		std::vector<csce::point<T>> compute_hull(std::vector<csce::point<T>>& points) {
+            return this->compute_hull(csce::point_span<T>(points));
+        }
+
+        /**
+        * Quick hull only reads its input, so the points are partitioned straight out of the span.
+        */
+        std::vector<csce::point<T>> compute_hull(const csce::point_span<T>& points) {
+            csce::scratch_arena::scope scope(this->scratch());
             std::vector<csce::point<T>> hull;
 
             auto left_most_point = get_left_most(points);
@@ -32,72 +42,72 @@ namespace csce {
             
             line<T> left_to_right = { left_most_point, right_most_point };
             line<T> right_to_left = { right_most_point, left_most_point };
-            auto p = pp(points, left_to_right);
+            csce::scratch_vector<csce::point<T>> upper(csce::arena_allocator<csce::point<T>>(&this->scratch()));
+            csce::scratch_vector<csce::point<T>> lower(csce::arena_allocator<csce::point<T>>(&this->scratch()));
+            pp(points, left_to_right, upper);
+            pp(points, right_to_left, lower);
 
-            get_hull(p.first, left_to_right, hull);
-            get_hull(p.second, right_to_left, hull);
+            get_hull(upper, left_to_right, hull);
+            get_hull(lower, right_to_left, hull);
 
             return hull;
         }
 
-        // first has ccw for a -> b, second has cw for a -> b
-        std::pair<std::vector<csce::point<T>>, std::vector<csce::point<T>>> pp(std::vector<csce::point<T>>& points, csce::line<T>& segment) {
-            std::pair<std::vector<csce::point<T>>, std::vector<csce::point<T>>> partition;
-            partition.first = { };
-            partition.second = { };
-
-            for (int i = 0; i < points.size(); i++) {
-                if (segment.to_vector2d().ccw(csce::vector2d<T>(segment.a, points[i]))) {
-                    partition.first.push_back(points[i]);
-                } else if (segment.to_vector2d().cw(csce::vector2d<T>(segment.a, points[i]))) {
-                    partition.second.push_back(points[i]);
+        // Copies the points that are ccw for a -> b into output. The mask and output are taken from the arena.
+        template<typename Points>
+        void pp(const Points& points, const csce::line<T>& segment, csce::scratch_vector<csce::point<T>>& output) {
+            csce::scratch_vector<std::uint64_t> ccw((points.size() + 63) / 64, 0, csce::arena_allocator<std::uint64_t>(&this->scratch()));
+            std::size_t ccw_count = 0;
+            csce::orientation_kernels::mark(points.data(), points.size(), segment.a, segment.b, 1, ccw.data());
+            for (std::size_t i = 0; i < ccw.size(); i++) {
+                ccw_count += __builtin_popcountll(ccw[i]);
+            }
+            output.reserve(ccw_count); //a vector in the arena leaves its old buffer behind when it grows
+            for (std::size_t i = 0; i < points.size(); i++) {
+                if ((ccw[i / 64] >> (i % 64)) & 1) {
+                    output.push_back(points[i]);
                 }
             }
-
-            return partition;
         }
 
-        void get_hull(std::vector<csce::point<T>>& points, csce::line<T>& boundary, std::vector<csce::point<T>>& hull) {
+        void get_hull(const csce::scratch_vector<csce::point<T>>& points, const csce::line<T>& boundary, std::vector<csce::point<T>>& hull) {
             if (points.size() == 0) {
                 return;
             }
 
+            //the partitions of this level are given back to the arena before the caller partitions its other side,
+            //so the scratch memory in use is that of the levels above this one, and not of every level so far
+            csce::scratch_arena::scope scope(this->scratch());
             auto hull_point = find_hull_point(points, boundary);
             hull.push_back(hull_point);
 
             csce::line<T> a = { boundary.a, hull_point };
-            auto left = pp(points, a).first;
+            csce::scratch_vector<csce::point<T>> left(csce::arena_allocator<csce::point<T>>(&this->scratch()));
+            pp(points, a, left);
 
             csce::line<T> b = { hull_point, boundary.b };
-            auto right = pp(points, b).first;
+            csce::scratch_vector<csce::point<T>> right(csce::arena_allocator<csce::point<T>>(&this->scratch()));
+            pp(points, b, right);
 
             get_hull(left, a, hull);
             get_hull(right, b, hull);
         }
 
         /** 
-        * Has no concept of orientation.  Will grab the maximal distance point
-        * on either side of the boundary.  Therefore, must pass a line segment
-        * that is a boundary (i.e. all points are on one side of the line and
-        * within the bounds of the boundary end points).
+        * Grabs the point with the maximal distance to the left of the boundary
+        * (the largest signed area), which is the farthest point right of the
+        * reversed boundary. Therefore, must pass the points that are left of
+        * the boundary.
         */
-        csce::point<T> find_hull_point(std::vector<csce::point<T>>& points, csce::line<T>& boundary) {
+        csce::point<T> find_hull_point(const csce::scratch_vector<csce::point<T>>& points, const csce::line<T>& boundary) {
             if (points.size() == 0) {
                 throw "No points to find maximal distance!";
             }
             
-            int index_of_maxial = 0;
-            for (int i = 1; i < points.size(); i++) {
-                auto dist = boundary.distance_to(points[i]);
-                auto max = boundary.distance_to(points[index_of_maxial]);
-                if (csce::math_utility::less_than(max, dist)) {
-                    index_of_maxial = i;
-                }
-            }
-            return points[index_of_maxial];
+            return points[csce::orientation_kernels::farthest(points.data(), points.size(), boundary.b, boundary.a)];
         }
 
-        csce::point<T> get_left_most(std::vector<csce::point<T>>& points) {
+        csce::point<T> get_left_most(const csce::point_span<T>& points) {
             if (points.size() == 0) {
                 throw "There are no points!";
             }
@@ -106,7 +116,8 @@ namespace csce {
             auto start = points.begin();
             auto end = points.end();
             for (auto current_point = start; current_point != end; current_point++) {
-                if (left_most.x <= current_point->x) {
+                //the lowest of the leftmost points, so that it is a corner of the hull
+                if (left_most.x < current_point->x || (left_most.x == current_point->x && left_most.y <= current_point->y)) {
                     continue;
                 }
                 left_most = *current_point;
@@ -115,7 +126,7 @@ namespace csce {
             return left_most;
         } 
 
-        csce::point<T> get_right_most(std::vector<csce::point<T>>& points) {
+        csce::point<T> get_right_most(const csce::point_span<T>& points) {
             if (points.size() == 0) {
                 throw "There are no points!";
             }
@@ -124,7 +135,8 @@ namespace csce {
             auto start = points.begin();
             auto end = points.end();
             for (auto current_point = start; current_point != end; current_point++) {
-                if (right_most.x >= current_point->x) {
+                //the highest of the rightmost points
+                if (right_most.x > current_point->x || (right_most.x == current_point->x && right_most.y >= current_point->y)) {
                     continue;
                 }
                 right_most = *current_point;
@@ -0,0 +1,117 @@
+#ifndef quick_hull_inplace_hpp
+#define quick_hull_inplace_hpp
+
+#include <vector>
+#include <string>
+#include <algorithm>
+
+#include "convex_hull_base.hpp"
+#include "point.hpp"
+#include "monotone_chain.hpp"
+#include "orientation_kernels.hpp"
+
+namespace csce {
+	/**
+	 * Quick hull that partitions the input vector in place using index ranges instead of
+	 * copying every partition into new vectors. The farthest point from a boundary is found
+	 * with the signed area (cross product), which orders points the same way as the distance
+	 * to the boundary line without the square root and division. The only allocation is the
+	 * returned hull.
+	 */
+	template<typename T>
+	class quick_hull_inplace : public csce::convex_hull_base<T> {
+	public:
+		using csce::convex_hull_base<T>::compute_hull;
+		
+		quick_hull_inplace(int _nthreads) : csce::convex_hull_base<T>(_nthreads) {}
+
+
+		std::string name() const {
+			return "Quick Hull (In-Place)";
+		}
+
+
+		/**
+		 * Returns the hull in counterclockwise order starting at the left-most point. The input
+		 * points are reordered.
+		 */
+		virtual std::vector<csce::point<T>> compute_hull(std::vector<csce::point<T>>& points) {
+			if(points.empty()){
+				return points;
+			}
+
+			csce::point<T> left = points[0];
+			csce::point<T> right = points[0];
+			for(auto& p : points){
+				if(csce::monotone_chain<T>::lexicographic_less(p, left)){
+					left = p;
+				}
+				if(csce::monotone_chain<T>::lexicographic_less(right, p)){
+					right = p;
+				}
+			}
+
+			if(left == right){
+				return std::vector<csce::point<T>>(1, left);
+			}
+
+			//points below the left-right line go first, followed by the points above it
+			auto begin = points.begin();
+			auto lower_end = std::partition(begin, points.end(), [&](const csce::point<T>& p) { return csce::monotone_chain<T>::cross(left, right, p) < 0; });
+			auto upper_end = std::partition(lower_end, points.end(), [&](const csce::point<T>& p) { return csce::monotone_chain<T>::cross(right, left, p) < 0; });
+
+			std::size_t lower_begin = 0;
+			std::size_t upper_begin = lower_end - begin;
+			std::size_t lower_count = this->get_hull(points, lower_begin, upper_begin, left, right);
+			std::size_t upper_count = this->get_hull(points, upper_begin, upper_end - begin, right, left);
+
+			std::vector<csce::point<T>> hull;
+			hull.reserve(lower_count + upper_count + 2);
+			hull.push_back(left);
+			hull.insert(hull.end(), begin, begin + lower_count);
+			hull.push_back(right);
+			hull.insert(hull.end(), begin + upper_begin, begin + upper_begin + upper_count);
+			return hull;
+		}
+
+
+		~quick_hull_inplace() {}
+
+
+	private:
+
+		/**
+		 * All of the points in [lo, hi) are strictly to the right of a->b. Moves the hull vertices
+		 * strictly between a and b, in counterclockwise order, to the front of the range and
+		 * returns how many there are.
+		 */
+		std::size_t get_hull(std::vector<csce::point<T>>& points, std::size_t lo, std::size_t hi, const csce::point<T>& a, const csce::point<T>& b) const {
+			if(lo == hi){
+				return 0;
+			}
+
+			//the farthest point to the right of a->b has the most negative signed area. Ties are on a
+			//line parallel to a->b, where only the two ends are vertices, so take the one closest to b.
+			std::size_t farthest = lo + csce::orientation_kernels::farthest(points.data() + lo, hi - lo, a, b);
+			csce::point<T> c = points[farthest];
+
+			//[lo, mid) is right of a->c, [mid, end) is right of c->b, and the rest is inside the triangle
+			auto begin = points.begin();
+			std::size_t mid = std::partition(begin + lo, begin + hi, [&](const csce::point<T>& p) { return csce::monotone_chain<T>::cross(a, c, p) < 0; }) - begin;
+			std::size_t end = std::partition(begin + mid, begin + hi, [&](const csce::point<T>& p) { return csce::monotone_chain<T>::cross(c, b, p) < 0; }) - begin;
+
+			//c is inside [end, hi), so shift the right partition over by one and store c between the partitions
+			std::swap(points[mid], points[end]);
+			points[mid] = c;
+
+			std::size_t left_count = this->get_hull(points, lo, mid, a, c);
+			std::size_t right_count = this->get_hull(points, mid + 1, end + 1, c, b);
+
+			points[lo + left_count] = c;
+			std::copy(begin + mid + 1, begin + mid + 1 + right_count, begin + lo + left_count + 1);
+			return left_count + 1 + right_count;
+		}
+	};
+}
+
+#endif /* quick_hull_inplace_hpp */
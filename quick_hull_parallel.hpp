@@ -5,104 +5,204 @@
 #include <string>
 #include <iostream>
 #include <utility>
-#include <thread>
-#include <mutex>
+#include <cstdint>
 
 #include "convex_hull_base.hpp"
 #include "point.hpp"
 #include "line.hpp"
-#include "vector2d.hpp"
-#include "math_utility.hpp"
+#include "orientation_kernels.hpp"
+#include "executor.hpp"
 
 namespace csce {
 	template<typename T>
 	class quick_hull_parallel : public csce::convex_hull_base<T> {
 	public:
+		using csce::convex_hull_base<T>::compute_hull;
+		
 		quick_hull_parallel(int _nthreads) : csce::convex_hull_base<T>(_nthreads) { }
 		
 		std::string name() const {
 			return "Quick Hull (Parallel)";
 		}
 
+        /**
+        * Returns the hull in clockwise order: the left-most point, the hull above the
+        * left-right line, the right-most point, and the hull below the left-right line.
+        */
         std::vector<csce::point<T>> compute_hull(std::vector<csce::point<T>>& points) {
-            auto left_most_point = get_left_most(points);
-            this->hull.push_back(left_most_point);
-            auto right_most_point = get_right_most(points);
-            this->hull.push_back(right_most_point);
+            return this->compute_hull(csce::point_span<T>(points));
+        }
+
+        /**
+        * The same hull of points that are only read, never copied as a whole or reordered. The
+        * extreme points and the partitions are found with parallel_for, so the passes over all of
+        * the points run on every thread, not just the first two sub-problems.
+        */
+        std::vector<csce::point<T>> compute_hull(const csce::point_span<T>& points) {
+            csce::executor& scheduler = this->executor();
+
+            csce::point<T> left_most_point;
+            csce::point<T> right_most_point;
+            get_extremes(scheduler, points, left_most_point, right_most_point);
             
             line<T> left_to_right = { left_most_point, right_most_point };
             line<T> right_to_left = { right_most_point, left_most_point };
-            auto partition = pp(points, left_to_right);
+            std::vector<csce::point<T>> above = pp(scheduler, points, left_to_right);
+            std::vector<csce::point<T>> below = pp(scheduler, points, right_to_left);
 
-            std::thread l_thread(&csce::quick_hull_parallel<T>::get_hull, this, partition.first, left_to_right);
-            std::thread r_thread(&csce::quick_hull_parallel<T>::get_hull, this, partition.second, right_to_left);
-            
-            l_thread.join();
-            r_thread.join();
+            std::vector<csce::point<T>> upper;
+            std::vector<csce::point<T>> lower;
+            scheduler.fork_join(2, [&](std::size_t x) {
+                if (x == 0) {
+                    this->get_hull(scheduler, below, right_to_left, lower);
+                } else {
+                    this->get_hull(scheduler, above, left_to_right, upper);
+                }
+            });
 
-            return this->hull;
+            std::vector<csce::point<T>> hull;
+            hull.reserve(upper.size() + lower.size() + 2);
+            hull.push_back(left_most_point);
+            hull.insert(hull.end(), upper.begin(), upper.end());
+            hull.push_back(right_most_point);
+            hull.insert(hull.end(), lower.begin(), lower.end());
+            return hull;
         }
 
-        void get_hull(const std::vector<csce::point<T>>& points, const csce::line<T>& boundary) {
+        /**
+        * Appends the hull vertices strictly between boundary.a and boundary.b to output, in order.
+        * Above the task cutoff, the left sub-problem is spawned as a task that idle workers can
+        * steal, and each sub-problem collects its vertices in its own buffer.
+        */
+        void get_hull(csce::executor& scheduler, const std::vector<csce::point<T>>& points, const csce::line<T>& boundary, std::vector<csce::point<T>>& output) {
             if (points.size() == 0) {
                 return;
             }
 
-            auto hull_point = find_hull_point(points, boundary);
-            this->mut.lock();
-            this->hull.push_back(hull_point);
-            this->mut.unlock();
+            auto hull_point = find_hull_point(scheduler, points, boundary);
 
             csce::line<T> a = { boundary.a, hull_point };
-            auto left = pp(points, a).first;
+            std::vector<csce::point<T>> left = pp(scheduler, points, a);
 
             csce::line<T> b = { hull_point, boundary.b };
-            auto right = pp(points, b).first;
+            std::vector<csce::point<T>> right = pp(scheduler, points, b);
+
+            std::vector<csce::point<T>> left_hull;
+            std::vector<csce::point<T>> right_hull;
+            if (left.size() >= task_cutoff && right.size() > 0) {
+                scheduler.fork_join(2, [&](std::size_t x) {
+                    if (x == 0) {
+                        this->get_hull(scheduler, right, b, right_hull);
+                    } else {
+                        this->get_hull(scheduler, left, a, left_hull);
+                    }
+                });
+            } else {
+                get_hull(scheduler, left, a, left_hull);
+                get_hull(scheduler, right, b, right_hull);
+            }
 
-            get_hull(left, a);
-            get_hull(right, b);
+            output.insert(output.end(), left_hull.begin(), left_hull.end());
+            output.push_back(hull_point);
+            output.insert(output.end(), right_hull.begin(), right_hull.end());
         }
 
-        // first has ccw for a -> b, second has cw for a -> b
-        std::pair<std::vector<csce::point<T>>, std::vector<csce::point<T>>> pp(const std::vector<csce::point<T>>& points, const csce::line<T>& segment) const {
-            std::pair<std::vector<csce::point<T>>, std::vector<csce::point<T>>> partition;
-            partition.first = { };
-            partition.second = { };
-
-            for (int i = 0; i < points.size(); i++) {
-                if (segment.to_vector2d().ccw(csce::vector2d<T>(segment.a, points[i]))) {
-                    partition.first.push_back(points[i]);
-                } else if (segment.to_vector2d().cw(csce::vector2d<T>(segment.a, points[i]))) {
-                    partition.second.push_back(points[i]);
+        /**
+        * Returns the points that are ccw for a -> b, in their order. Each chunk of the points marks
+        * its own points, and then copies them to where the counts of the chunks before it end.
+        */
+        template<typename Points>
+        std::vector<csce::point<T>> pp(csce::executor& scheduler, const Points& points, const csce::line<T>& segment) const {
+            std::size_t chunks = scheduler.chunk_count(points.size(), chunk_cutoff);
+            if (chunks == 1) {
+                return pp(points, segment); //without the second pass over the marks, which only pays off in parallel
+            }
+
+            std::vector<std::vector<std::uint64_t>> marks(chunks);
+            std::vector<std::size_t> offsets(chunks + 1, 0);
+            scheduler.parallel_for(points.size(), chunk_cutoff, [&](std::size_t chunk, std::size_t begin, std::size_t end) {
+                marks[chunk].assign((end - begin + 63) / 64, 0);
+                csce::orientation_kernels::mark(points.data() + begin, end - begin, segment.a, segment.b, 1, marks[chunk].data());
+                for (std::size_t i = 0; i < marks[chunk].size(); i++) {
+                    offsets[chunk + 1] += __builtin_popcountll(marks[chunk][i]);
                 }
+            });
+            for (std::size_t chunk = 0; chunk < chunks; chunk++) {
+                offsets[chunk + 1] += offsets[chunk];
             }
 
+            std::vector<csce::point<T>> partition(offsets[chunks]);
+            scheduler.parallel_for(points.size(), chunk_cutoff, [&](std::size_t chunk, std::size_t begin, std::size_t end) {
+                std::size_t next = offsets[chunk];
+                for (std::size_t i = begin; i < end; i++) {
+                    if ((marks[chunk][(i - begin) / 64] >> ((i - begin) % 64)) & 1) {
+                        partition[next++] = points[i];
+                    }
+                }
+            });
+            return partition;
+        }
+
+        // the points that are ccw for a -> b, in their order
+        template<typename Points>
+        std::vector<csce::point<T>> pp(const Points& points, const csce::line<T>& segment) const {
+            std::vector<std::uint64_t> ccw((points.size() + 63) / 64);
+            std::size_t ccw_count = 0;
+            csce::orientation_kernels::mark(points.data(), points.size(), segment.a, segment.b, 1, ccw.data());
+            for (std::size_t i = 0; i < ccw.size(); i++) {
+                ccw_count += __builtin_popcountll(ccw[i]);
+            }
+
+            std::vector<csce::point<T>> partition;
+            partition.reserve(ccw_count);
+            for (std::size_t i = 0; i < points.size(); i++) {
+                if ((ccw[i / 64] >> (i % 64)) & 1) {
+                    partition.push_back(points[i]);
+                }
+            }
             return partition;
         }
 
         /** 
-        * Has no concept of orientation.  Will grab the maximal distance point
-        * on either side of the boundary.  Therefore, must pass a line segment
-        * that is a boundary (i.e. all points are on one side of the line and
-        * within the bounds of the boundary end points).
+        * Grabs the point with the maximal distance to the left of the boundary
+        * (the largest signed area), which is the farthest point right of the
+        * reversed boundary. Therefore, must pass the points that are left of
+        * the boundary. Each chunk finds its farthest point, and the farthest of
+        * those, in chunk order, is the one the whole array would give.
         */
-        csce::point<T> find_hull_point(const std::vector<csce::point<T>>& points, const csce::line<T>& boundary) const {
+        csce::point<T> find_hull_point(csce::executor& scheduler, const std::vector<csce::point<T>>& points, const csce::line<T>& boundary) const {
             if (points.size() == 0) {
                 throw "No points to find maximal distance!";
             }
             
-            int index_of_maximal = 0;
-            for (int i = 1; i < points.size(); i++) {
-                auto dist = boundary.distance_to(points[i]);
-                auto max = boundary.distance_to(points[index_of_maximal]);
-                if (csce::math_utility::less_than(max, dist)) {
-                    index_of_maximal = i;
-                }
+            std::vector<csce::point<T>> farthest(scheduler.chunk_count(points.size(), chunk_cutoff));
+            scheduler.parallel_for(points.size(), chunk_cutoff, [&](std::size_t chunk, std::size_t begin, std::size_t end) {
+                farthest[chunk] = points[begin + csce::orientation_kernels::farthest(points.data() + begin, end - begin, boundary.b, boundary.a)];
+            });
+            return farthest[csce::orientation_kernels::farthest(farthest.data(), farthest.size(), boundary.b, boundary.a)];
+        }
+
+        /**
+        * Finds the lowest of the leftmost points and the highest of the rightmost points, one chunk
+        * of the points per task.
+        */
+        void get_extremes(csce::executor& scheduler, const csce::point_span<T>& points, csce::point<T>& left_most, csce::point<T>& right_most) const {
+            if (points.size() == 0) {
+                throw "There are no points!";
             }
-            return points[index_of_maximal];
+
+            std::size_t chunks = scheduler.chunk_count(points.size(), chunk_cutoff);
+            std::vector<csce::point<T>> left(chunks);
+            std::vector<csce::point<T>> right(chunks);
+            scheduler.parallel_for(points.size(), chunk_cutoff, [&](std::size_t chunk, std::size_t begin, std::size_t end) {
+                left[chunk] = get_left_most(points.subspan(begin, end));
+                right[chunk] = get_right_most(points.subspan(begin, end));
+            });
+            left_most = get_left_most(csce::point_span<T>(left));
+            right_most = get_right_most(csce::point_span<T>(right));
         }
 
-        csce::point<T> get_left_most(const std::vector<csce::point<T>>& points) const {
+        csce::point<T> get_left_most(const csce::point_span<T>& points) const {
             if (points.size() == 0) {
                 throw "There are no points!";
             }
@@ -111,7 +211,8 @@ namespace csce {
             auto start = points.begin();
             auto end = points.end();
             for (auto current_point = start; current_point != end; current_point++) {
-                if (left_most.x <= current_point->x) {
+                //the lowest of the leftmost points, so that it is a corner of the hull
+                if (left_most.x < current_point->x || (left_most.x == current_point->x && left_most.y <= current_point->y)) {
                     continue;
                 }
                 left_most = *current_point;
@@ -120,7 +221,7 @@ namespace csce {
             return left_most;
         } 
 
-        csce::point<T> get_right_most(const std::vector<csce::point<T>>& points) const {
+        csce::point<T> get_right_most(const csce::point_span<T>& points) const {
             if (points.size() == 0) {
                 throw "There are no points!";
             }
@@ -129,7 +230,8 @@ namespace csce {
             auto start = points.begin();
             auto end = points.end();
             for (auto current_point = start; current_point != end; current_point++) {
-                if (right_most.x >= current_point->x) {
+                //the highest of the rightmost points
+                if (right_most.x > current_point->x || (right_most.x == current_point->x && right_most.y >= current_point->y)) {
                     continue;
                 }
                 right_most = *current_point;
@@ -144,9 +246,10 @@ namespace csce {
 		
 		
 	private:
-        int nthread;
-        std::vector<csce::point<T>> hull;
-        std::mutex mut;
+        //sub-problems smaller than this are not worth a task
+        static const std::size_t task_cutoff = 2048;
+        //and passes over fewer points than this per thread are not worth splitting
+        static const std::size_t chunk_cutoff = 1 << 15;
 	};
 }
 
@@ -0,0 +1,75 @@
+#include <algorithm>
+
+#include "radix_sort.hpp"
+
+namespace {
+	const int digit_bits = 8;
+	const std::size_t digit_count = std::size_t(1) << digit_bits;
+	const std::size_t minimum_chunk = 1 << 15; //smaller chunks are not worth a task
+}
+
+void csce::radix_sort::sort(csce::scratch_vector<std::uint64_t>& keys, csce::scratch_vector<std::uint32_t>& values, csce::executor& pool) {
+	if(keys.size() != values.size()){
+		throw "radix_sort::sort: there must be one value for every key";
+	}
+	std::size_t n = keys.size();
+	if(n < 2){
+		return;
+	}
+
+	std::size_t chunks = pool.chunk_count(n, minimum_chunk);
+
+	//the bits that differ between any two keys
+	csce::scratch_vector<std::uint64_t> differences(chunks, 0, keys.get_allocator());
+	pool.parallel_for(n, minimum_chunk, [&](std::size_t chunk, std::size_t begin, std::size_t end) {
+		std::uint64_t first = keys[0];
+		std::uint64_t difference = 0;
+		for(std::size_t x=begin; x<end; x++){
+			difference |= keys[x] ^ first;
+		}
+		differences[chunk] = difference;
+	});
+	std::uint64_t difference = 0;
+	for(auto d : differences){
+		difference |= d;
+	}
+
+	csce::scratch_vector<std::uint64_t> key_buffer(n, 0, keys.get_allocator());
+	csce::scratch_vector<std::uint32_t> value_buffer(n, 0, values.get_allocator());
+	csce::scratch_vector<std::size_t> offsets(chunks * digit_count, 0, keys.get_allocator());
+	for(int shift=0; shift<64; shift+=digit_bits){
+		if(((difference >> shift) & (digit_count - 1)) == 0){
+			continue;
+		}
+
+		pool.parallel_for(n, minimum_chunk, [&](std::size_t chunk, std::size_t begin, std::size_t end) {
+			std::size_t* count = &offsets[chunk * digit_count];
+			std::fill(count, count + digit_count, 0);
+			for(std::size_t x=begin; x<end; x++){
+				count[(keys[x] >> shift) & (digit_count - 1)]++;
+			}
+		});
+
+		//every digit starts after all smaller digits, and within a digit the chunks stay in order
+		std::size_t offset = 0;
+		for(std::size_t digit=0; digit<digit_count; digit++){
+			for(std::size_t chunk=0; chunk<chunks; chunk++){
+				std::size_t count = offsets[chunk * digit_count + digit];
+				offsets[chunk * digit_count + digit] = offset;
+				offset += count;
+			}
+		}
+
+		pool.parallel_for(n, minimum_chunk, [&](std::size_t chunk, std::size_t begin, std::size_t end) {
+			std::size_t* next = &offsets[chunk * digit_count];
+			for(std::size_t x=begin; x<end; x++){
+				std::size_t y = next[(keys[x] >> shift) & (digit_count - 1)]++;
+				key_buffer[y] = keys[x];
+				value_buffer[y] = values[x];
+			}
+		});
+
+		keys.swap(key_buffer);
+		values.swap(value_buffer);
+	}
+}
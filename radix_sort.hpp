@@ -0,0 +1,26 @@
+#ifndef radix_sort_hpp
+#define radix_sort_hpp
+
+#include <cstdint>
+#include <vector>
+
+#include "executor.hpp"
+#include "scratch_arena.hpp"
+
+namespace csce {
+	namespace radix_sort {
+		/**
+		 * Sorts the keys in ascending order and moves values[i] along with keys[i], with a least
+		 * significant digit radix sort over 8-bit digits. The sort is stable, so equal keys keep their
+		 * order. Digits that are the same in every key are skipped.
+		 *
+		 * Every pass splits the keys into one contiguous chunk per thread of the executor: the chunks'
+		 * digits are counted in parallel, and after a prefix sum over (digit, chunk) the chunks are
+		 * scattered into a second buffer in parallel, so each pass streams through memory twice.
+		 * The buffers come from the same arena as the keys.
+		 */
+		void sort(csce::scratch_vector<std::uint64_t>& keys, csce::scratch_vector<std::uint32_t>& values, csce::executor& pool);
+	}
+}
+
+#endif /* radix_sort_hpp */
@@ -0,0 +1,231 @@
+#include <cmath>
+
+#include "robust_predicates.hpp"
+
+//Adapted from Jonathan Richard Shewchuk, "Adaptive Precision Floating-Point Arithmetic and Fast
+//Robust Geometric Predicates" (1997). Expansions are arrays of doubles, smallest magnitude first,
+//whose exact sum is the value they represent. This relies on IEEE double arithmetic with
+//round to nearest, so it must not be built with -ffast-math or with x87 extended precision, and
+//the products must not be contracted into fused multiply-adds.
+#pragma GCC optimize("fp-contract=off")
+
+namespace {
+	const double epsilon = std::ldexp(1.0, -53); //half an ulp of 1
+	const double splitter = std::ldexp(1.0, 27) + 1.0;
+	const double result_error_bound = (3.0 + 8.0 * epsilon) * epsilon;
+	const double ccw_error_bound_a = (3.0 + 16.0 * epsilon) * epsilon;
+	const double ccw_error_bound_b = (2.0 + 12.0 * epsilon) * epsilon;
+	const double ccw_error_bound_c = (9.0 + 64.0 * epsilon) * epsilon * epsilon;
+
+	thread_local unsigned long long int slow_paths = 0;
+
+	//x + y == a + b exactly, for |a| >= |b|
+	inline void fast_two_sum(double a, double b, double& x, double& y) {
+		x = a + b;
+		double b_virtual = x - a;
+		y = b - b_virtual;
+	}
+
+	//x + y == a + b exactly
+	inline void two_sum(double a, double b, double& x, double& y) {
+		x = a + b;
+		double b_virtual = x - a;
+		double a_virtual = x - b_virtual;
+		double b_round = b - b_virtual;
+		double a_round = a - a_virtual;
+		y = a_round + b_round;
+	}
+
+	//the rounding error of x = a - b
+	inline double two_diff_tail(double a, double b, double x) {
+		double b_virtual = a - x;
+		double a_virtual = x + b_virtual;
+		double b_round = b_virtual - b;
+		double a_round = a - a_virtual;
+		return a_round + b_round;
+	}
+
+	inline void two_diff(double a, double b, double& x, double& y) {
+		x = a - b;
+		y = two_diff_tail(a, b, x);
+	}
+
+	//splits a into two halves of 26 bits each, a == high + low
+	inline void split(double a, double& high, double& low) {
+		double c = splitter * a;
+		double a_big = c - a;
+		high = c - a_big;
+		low = a - high;
+	}
+
+	//x + y == a * b exactly
+	inline void two_product(double a, double b, double& x, double& y) {
+		x = a * b;
+		double a_high, a_low, b_high, b_low;
+		split(a, a_high, a_low);
+		split(b, b_high, b_low);
+		double error1 = x - a_high * b_high;
+		double error2 = error1 - a_low * b_high;
+		double error3 = error2 - a_high * b_low;
+		y = a_low * b_low - error3;
+	}
+
+	//x[2] + x[1] + x[0] == a1 + a0 - b
+	inline void two_one_diff(double a1, double a0, double b, double x[3]) {
+		double i;
+		two_diff(a0, b, i, x[0]);
+		two_sum(a1, i, x[2], x[1]);
+	}
+
+	//x[3] + x[2] + x[1] + x[0] == a1 + a0 - (b1 + b0)
+	inline void two_two_diff(double a1, double a0, double b1, double b0, double x[4]) {
+		double j[3];
+		two_one_diff(a1, a0, b0, j);
+		x[0] = j[0];
+		two_one_diff(j[2], j[1], b1, x + 1);
+	}
+
+	//the difference a1 * b1 - a0 * b0 as a four component expansion
+	inline void product_difference(double a1, double b1, double a0, double b0, double x[4]) {
+		double s1, s0, t1, t0;
+		two_product(a1, b1, s1, s0);
+		two_product(a0, b0, t1, t0);
+		two_two_diff(s1, s0, t1, t0, x);
+	}
+
+	double estimate(int length, const double* e) {
+		double q = e[0];
+		for(int x=1; x<length; x++){
+			q += e[x];
+		}
+		return q;
+	}
+
+	/**
+	 * Writes the expansion e + f to h, without zero components, and returns its length.
+	 * h must have room for e_length + f_length components.
+	 */
+	int expansion_sum(int e_length, const double* e, int f_length, const double* f, double* h) {
+		int e_index = 0;
+		int f_index = 0;
+		int h_index = 0;
+		double e_now = e[0];
+		double f_now = f[0];
+		double q, q_new, hh;
+
+		//the components are taken in order of increasing magnitude
+		auto take_e = [&]() {
+			return f_index == f_length || (e_index < e_length && (f_now > e_now) == (f_now > -e_now));
+		};
+		auto next = [&](bool from_e) {
+			double value;
+			if(from_e){
+				value = e_now;
+				e_index++;
+				e_now = e_index < e_length ? e[e_index] : 0;
+			} else {
+				value = f_now;
+				f_index++;
+				f_now = f_index < f_length ? f[f_index] : 0;
+			}
+			return value;
+		};
+
+		q = next(take_e());
+		if(e_index < e_length && f_index < f_length){
+			fast_two_sum(next(take_e()), q, q_new, hh);
+			q = q_new;
+			if(hh != 0.0){
+				h[h_index++] = hh;
+			}
+		}
+		while(e_index < e_length || f_index < f_length){
+			two_sum(q, next(take_e()), q_new, hh);
+			q = q_new;
+			if(hh != 0.0){
+				h[h_index++] = hh;
+			}
+		}
+		if(q != 0.0 || h_index == 0){
+			h[h_index++] = q;
+		}
+		return h_index;
+	}
+
+	double orient2d_adaptive(double ax, double ay, double bx, double by, double cx, double cy, double detsum) {
+		slow_paths++;
+
+		double acx = ax - cx;
+		double bcx = bx - cx;
+		double acy = ay - cy;
+		double bcy = by - cy;
+
+		//the determinant of the rounded differences, exactly
+		double b[4];
+		product_difference(acx, bcy, acy, bcx, b);
+		double det = estimate(4, b);
+		double error_bound = ccw_error_bound_b * detsum;
+		if(det >= error_bound || -det >= error_bound){
+			return det;
+		}
+
+		double acx_tail = two_diff_tail(ax, cx, acx);
+		double bcx_tail = two_diff_tail(bx, cx, bcx);
+		double acy_tail = two_diff_tail(ay, cy, acy);
+		double bcy_tail = two_diff_tail(by, cy, bcy);
+		if(acx_tail == 0.0 && acy_tail == 0.0 && bcx_tail == 0.0 && bcy_tail == 0.0){
+			return det; //the differences were exact, so b is the exact determinant
+		}
+
+		//first order correction for the rounding of the differences
+		error_bound = ccw_error_bound_c * detsum + result_error_bound * std::abs(det);
+		det += (acx * bcy_tail + bcy * acx_tail) - (acy * bcx_tail + bcx * acy_tail);
+		if(det >= error_bound || -det >= error_bound){
+			return det;
+		}
+
+		//the exact determinant: b plus every product with a tail
+		double u[4], c1[8], c2[12], d[16];
+		product_difference(acx_tail, bcy, acy_tail, bcx, u);
+		int c1_length = expansion_sum(4, b, 4, u, c1);
+		product_difference(acx, bcy_tail, acy, bcx_tail, u);
+		int c2_length = expansion_sum(c1_length, c1, 4, u, c2);
+		product_difference(acx_tail, bcy_tail, acy_tail, bcx_tail, u);
+		int d_length = expansion_sum(c2_length, c2, 4, u, d);
+		return d[d_length - 1];
+	}
+}
+
+double csce::robust_predicates::orient2d(double ax, double ay, double bx, double by, double cx, double cy) {
+	double detleft = (ax - cx) * (by - cy);
+	double detright = (ay - cy) * (bx - cx);
+	double det = detleft - detright;
+	double detsum;
+
+	//when the two products have different signs, the difference cannot be rounded to the wrong sign
+	if(detleft > 0){
+		if(detright <= 0){
+			return det;
+		}
+		detsum = detleft + detright;
+	} else if(detleft < 0){
+		if(detright >= 0){
+			return det;
+		}
+		detsum = -detleft - detright;
+	} else {
+		return det;
+	}
+
+	double error_bound = ccw_error_bound_a * detsum;
+	if(det >= error_bound || -det >= error_bound){
+		return det;
+	}
+	return orient2d_adaptive(ax, ay, bx, by, cx, cy, detsum);
+}
+
+const double csce::robust_predicates::orient2d_error_bound = ccw_error_bound_a;
+
+unsigned long long int csce::robust_predicates::slow_path_count() {
+	return slow_paths;
+}
@@ -0,0 +1,30 @@
+#ifndef robust_predicates_hpp
+#define robust_predicates_hpp
+
+namespace csce {
+	namespace robust_predicates {
+		/**
+		 * Returns a positive value if a, b, c make a counterclockwise turn, a negative value if they
+		 * make a clockwise turn and zero if they are collinear, with the sign always exact for double
+		 * coordinates (Shewchuk's adaptive orient2d). The determinant is first computed in plain
+		 * double arithmetic and returned if it is larger than a static bound on its rounding error,
+		 * which is the case for almost every call. Otherwise it is recomputed with more and more of
+		 * the rounding error kept in floating point expansions, up to the exact value.
+		 */
+		double orient2d(double ax, double ay, double bx, double by, double cx, double cy);
+
+		/**
+		 * The relative error bound of orient2d's fast path: when the rounded determinant is larger in
+		 * magnitude than this times |detleft| + |detright|, its sign is correct.
+		 */
+		extern const double orient2d_error_bound;
+
+		/**
+		 * The number of orient2d calls so far that needed more than the fast path. Counted per
+		 * thread, so it is only meant for tests and benchmarks.
+		 */
+		unsigned long long int slow_path_count();
+	}
+}
+
+#endif /* robust_predicates_hpp */
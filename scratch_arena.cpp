@@ -0,0 +1,189 @@
+#include "scratch_arena.hpp"
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstdint>
+#include <sys/mman.h>
+
+namespace {
+	const std::size_t minimum_block = std::size_t(1) << 16;
+	const std::size_t block_alignment = 64;
+	const std::size_t page_size = 4096;
+	const std::size_t huge_page_size = std::size_t(1) << 21;
+
+	std::size_t align_up(std::size_t value, std::size_t alignment) {
+		return (value + alignment - 1) & ~(alignment - 1);
+	}
+}
+
+csce::scratch_arena::scope::scope(scratch_arena& _arena) : arena(_arena) {
+	std::lock_guard<std::mutex> lock(this->arena.mutex);
+	this->block = this->arena.current;
+	this->offset = this->arena.offset;
+	this->arena.depth++;
+}
+
+csce::scratch_arena::scope::~scope() {
+	std::lock_guard<std::mutex> lock(this->arena.mutex);
+	this->arena.current = this->block;
+	this->arena.offset = this->offset;
+	this->arena.depth--;
+	if(this->arena.depth == 0){
+		this->arena.consolidate();
+	}
+}
+
+csce::scratch_arena::scratch_arena(bool _huge_pages, bool _prefault) : use_huge_pages(_huge_pages), prefault(_prefault) {
+	this->blocks.reserve(64); //a new block is rare, and should not also grow this
+}
+
+csce::scratch_arena::~scratch_arena() {
+	for(auto& b : this->blocks){
+		this->free_block(b);
+	}
+}
+
+void* csce::scratch_arena::allocate(std::size_t bytes, std::size_t alignment) {
+	std::lock_guard<std::mutex> lock(this->mutex);
+	bytes = std::max<std::size_t>(1, bytes);
+
+	//the rest of the current block, then any later blocks that a scope has rewound past
+	while(this->current < this->blocks.size()){
+		block& b = this->blocks[this->current];
+		std::size_t start = align_up(reinterpret_cast<std::uintptr_t>(b.data) + this->offset, alignment) - reinterpret_cast<std::uintptr_t>(b.data);
+		if(start + bytes <= b.size){
+			this->offset = start + bytes;
+			this->used = start + bytes;
+			for(std::size_t x=0; x<this->current; x++){
+				this->used += this->blocks[x].size;
+			}
+			this->peak_used = std::max(this->peak_used, this->used);
+			return b.data + start;
+		}
+		this->current++;
+		this->offset = 0;
+	}
+
+	std::size_t size = std::max(minimum_block, bytes + alignment);
+	if(!this->blocks.empty()){
+		size = std::max(size, 2 * this->blocks.back().size);
+	}
+	this->blocks.push_back(this->allocate_block(size));
+	this->current = this->blocks.size() - 1;
+
+	block& b = this->blocks.back();
+	std::size_t start = align_up(reinterpret_cast<std::uintptr_t>(b.data), alignment) - reinterpret_cast<std::uintptr_t>(b.data);
+	this->offset = start + bytes;
+	this->used = this->offset;
+	for(std::size_t x=0; x<this->current; x++){
+		this->used += this->blocks[x].size;
+	}
+	this->peak_used = std::max(this->peak_used, this->used);
+	return b.data + start;
+}
+
+void csce::scratch_arena::reserve(std::size_t bytes) {
+	std::lock_guard<std::mutex> lock(this->mutex);
+	if(this->depth > 0){
+		throw "scratch_arena::reserve: the arena is in use";
+	}
+	if(!this->blocks.empty() && this->blocks.front().size >= bytes){
+		return;
+	}
+	for(auto& b : this->blocks){
+		this->free_block(b);
+	}
+	this->blocks.clear();
+	this->blocks.push_back(this->allocate_block(bytes));
+	this->current = 0;
+	this->offset = 0;
+}
+
+std::size_t csce::scratch_arena::block_allocations() const {
+	std::lock_guard<std::mutex> lock(this->mutex);
+	return this->allocations;
+}
+
+std::size_t csce::scratch_arena::capacity() const {
+	std::lock_guard<std::mutex> lock(this->mutex);
+	std::size_t total = 0;
+	for(auto& b : this->blocks){
+		total += b.size;
+	}
+	return total;
+}
+
+std::size_t csce::scratch_arena::peak() const {
+	std::lock_guard<std::mutex> lock(this->mutex);
+	return this->peak_used;
+}
+
+bool csce::scratch_arena::huge_pages() const {
+	std::lock_guard<std::mutex> lock(this->mutex);
+	return this->use_huge_pages;
+}
+
+csce::scratch_arena::block csce::scratch_arena::allocate_block(std::size_t bytes) {
+	block b = { nullptr, bytes, false };
+	this->allocations++;
+
+	if(this->use_huge_pages){
+		b.size = align_up(bytes, huge_page_size);
+#ifdef MAP_HUGETLB
+		void* memory = mmap(nullptr, b.size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+#else
+		void* memory = MAP_FAILED;
+#endif
+		if(memory == MAP_FAILED){
+			//no reserved huge pages, so ask for transparent ones instead
+			memory = mmap(nullptr, b.size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+#ifdef MADV_HUGEPAGE
+			if(memory != MAP_FAILED && madvise(memory, b.size, MADV_HUGEPAGE) != 0){
+				this->use_huge_pages = false;
+			}
+#else
+			this->use_huge_pages = false;
+#endif
+		}
+		if(memory == MAP_FAILED){
+			throw std::bad_alloc();
+		}
+		b.data = static_cast<char*>(memory);
+		b.mapped = true;
+	} else {
+		void* memory = nullptr;
+		if(posix_memalign(&memory, block_alignment, b.size) != 0){
+			throw std::bad_alloc();
+		}
+		b.data = static_cast<char*>(memory);
+	}
+
+	if(this->prefault){
+		for(std::size_t x=0; x<b.size; x+=page_size){
+			b.data[x] = 0;
+		}
+	}
+	return b;
+}
+
+void csce::scratch_arena::free_block(const block& b) {
+	if(b.mapped){
+		munmap(b.data, b.size);
+	} else {
+		std::free(b.data);
+	}
+}
+
+void csce::scratch_arena::consolidate() {
+	if(this->blocks.size() < 2 || this->current != 0 || this->offset != 0){
+		return;
+	}
+
+	std::size_t total = 0;
+	for(auto& b : this->blocks){
+		total += b.size;
+		this->free_block(b);
+	}
+	this->blocks.clear();
+	this->blocks.push_back(this->allocate_block(total));
+}
@@ -0,0 +1,168 @@
+#ifndef scratch_arena_hpp
+#define scratch_arena_hpp
+
+#include <vector>
+#include <mutex>
+#include <new>
+#include <type_traits>
+
+namespace csce {
+	/**
+	 * A monotonic allocator for the temporary buffers of a hull computation. Memory is handed out
+	 * from large blocks by bumping an offset and is never freed one buffer at a time: a scope
+	 * records the offset when it is opened and rewinds to it when it closes, so the scopes of an
+	 * algorithm and of the algorithms it calls nest like a stack.
+	 *
+	 * When the outermost scope closes after a call needed more than one block, the blocks are
+	 * replaced by a single block as large as all of them. From then on a call of the same size
+	 * fits in that block, and repeated calls do not allocate from the system at all, which
+	 * block_allocations() shows.
+	 *
+	 * The blocks can be backed by huge pages and touched as soon as they are allocated (prefaulted),
+	 * so that the first call does not take a page fault per page either. Tasks may allocate from
+	 * the arena concurrently, but only the thread that owns the arena opens and closes scopes.
+	 */
+	class scratch_arena {
+	public:
+		class scope {
+		public:
+			scope(scratch_arena& _arena);
+			~scope();
+
+		private:
+			scope(const scope&);
+			scope& operator=(const scope&);
+
+			scratch_arena& arena;
+			std::size_t block;
+			std::size_t offset;
+		};
+
+
+		scratch_arena(bool _huge_pages = false, bool _prefault = false);
+		~scratch_arena();
+
+
+		/**
+		 * Returns bytes of memory aligned to alignment (a power of two), which stays valid until the
+		 * innermost open scope closes.
+		 */
+		void* allocate(std::size_t bytes, std::size_t alignment);
+
+
+		/**
+		 * Makes sure that the first block can hold bytes, so that calls that need up to that much
+		 * scratch memory never allocate.
+		 */
+		void reserve(std::size_t bytes);
+
+
+		/**
+		 * The number of blocks requested from the system since the arena was created.
+		 */
+		std::size_t block_allocations() const;
+
+
+		/**
+		 * The total size of the blocks that the arena currently holds.
+		 */
+		std::size_t capacity() const;
+
+
+		/**
+		 * The most memory that was in use at once.
+		 */
+		std::size_t peak() const;
+
+
+		/**
+		 * Whether the blocks are backed by huge pages. If the system has none to give, the arena
+		 * falls back to normal pages.
+		 */
+		bool huge_pages() const;
+
+
+	private:
+		struct block {
+			char* data;
+			std::size_t size;
+			bool mapped;
+		};
+
+		scratch_arena(const scratch_arena&);
+		scratch_arena& operator=(const scratch_arena&);
+
+		block allocate_block(std::size_t bytes);
+		void free_block(const block& b);
+		void consolidate();
+
+		bool use_huge_pages;
+		bool prefault;
+		std::vector<block> blocks;
+		std::size_t current = 0;
+		std::size_t offset = 0;
+		std::size_t depth = 0;
+		std::size_t used = 0;
+		std::size_t peak_used = 0;
+		std::size_t allocations = 0;
+		mutable std::mutex mutex;
+	};
+
+
+	/**
+	 * An allocator for standard containers that takes its memory from a scratch_arena and never
+	 * gives it back (the arena's scope does). Without an arena it uses the heap, so the same
+	 * container type works with and without one.
+	 */
+	template<typename T>
+	struct arena_allocator {
+		typedef T value_type;
+		typedef std::true_type propagate_on_container_copy_assignment;
+		typedef std::true_type propagate_on_container_move_assignment;
+		typedef std::true_type propagate_on_container_swap;
+
+		template<typename U>
+		struct rebind {
+			typedef arena_allocator<U> other;
+		};
+
+		arena_allocator(csce::scratch_arena* _arena = nullptr) : arena(_arena) {}
+
+		template<typename U>
+		arena_allocator(const arena_allocator<U>& other) : arena(other.arena) {}
+
+		T* allocate(std::size_t n) {
+			if(this->arena == nullptr){
+				return static_cast<T*>(::operator new(n * sizeof(T)));
+			}
+			return static_cast<T*>(this->arena->allocate(n * sizeof(T), alignof(T)));
+		}
+
+		void deallocate(T* memory, std::size_t) {
+			if(this->arena == nullptr){
+				::operator delete(memory);
+			}
+		}
+
+		template<typename U>
+		bool operator==(const arena_allocator<U>& other) const {
+			return this->arena == other.arena;
+		}
+
+		template<typename U>
+		bool operator!=(const arena_allocator<U>& other) const {
+			return this->arena != other.arena;
+		}
+
+		csce::scratch_arena* arena;
+	};
+
+
+	/**
+	 * A vector whose buffer comes from a scratch_arena (or the heap, without one).
+	 */
+	template<typename T>
+	using scratch_vector = std::vector<T, csce::arena_allocator<T>>;
+}
+
+#endif /* scratch_arena_hpp */
@@ -0,0 +1,129 @@
+#ifndef sliding_window_hull_hpp
+#define sliding_window_hull_hpp
+
+#include <vector>
+#include <limits>
+#include <utility>
+
+#include "point.hpp"
+#include "hull_merge.hpp"
+#include "incremental_hull.hpp"
+
+namespace csce {
+	/**
+	 * The convex hull of a sliding window over a stream of timestamped points. The window holds
+	 * at most max_points points, none of which are older than max_age (in the same unit as the
+	 * timestamps, which must not decrease).
+	 *
+	 * The window is a queue made of two stacks. New points go on the back stack, whose hull is
+	 * kept in an incremental_hull. Points leave from the front stack, which has an incremental_hull
+	 * of its own. When the front stack runs out, the back stack is moved over newest point first,
+	 * and every entry records what inserting its point changed in the front hull. The oldest point
+	 * is inserted last, so it is popped by undoing its change, which leaves the hull of the newer
+	 * points. Since an insertion erases every chain point at most once, the records hold O(W)
+	 * points in total for a window of W points, and a step costs O(log h) amortized to maintain
+	 * and O(h) to read the hull of the window (the front hull combined with the back hull).
+	 */
+	template<typename T>
+	class sliding_window_hull {
+	public:
+		sliding_window_hull(std::size_t _max_points, double _max_age = std::numeric_limits<double>::infinity()) : max_points(_max_points), max_age(_max_age) {}
+
+
+		/**
+		 * Adds a point at the given time and drops the points that left the window.
+		 */
+		void push(double timestamp, const csce::point<T>& p) {
+			this->back.push_back(record{timestamp, p});
+			this->back_hull.insert(p);
+			this->expire(timestamp);
+		}
+
+
+		/**
+		 * Drops the points that are older than max_age at the given time, without adding a point.
+		 */
+		void expire(double now) {
+			while(this->size() > this->max_points || (!this->empty() && this->oldest() <= now - this->max_age)){
+				this->pop();
+			}
+		}
+
+
+		/**
+		 * Returns the hull of the window as a counterclockwise polygon starting at the left-most point.
+		 */
+		std::vector<csce::point<T>> hull() const {
+			csce::hull_chains<T> chains = this->chains(this->back_hull);
+			if(!this->front.empty()){
+				chains = csce::hull_merge::combine(this->chains(this->front_hull), chains);
+			}
+			return csce::hull_merge::to_polygon(chains);
+		}
+
+
+		/**
+		 * The number of points in the window.
+		 */
+		std::size_t size() const {
+			return this->front.size() + this->back.size();
+		}
+
+
+		bool empty() const {
+			return this->size() == 0;
+		}
+
+
+	private:
+		struct record {
+			double timestamp;
+			csce::point<T> p;
+		};
+
+		struct entry {
+			double timestamp;
+			typename csce::incremental_hull<T>::change inserted; //what adding this point to the hull of the newer points in the front stack changed
+		};
+
+		std::size_t max_points;
+		double max_age;
+		std::vector<entry> front; //the oldest point is at the back
+		std::vector<record> back; //the oldest point is at the front
+		csce::incremental_hull<T> front_hull;
+		csce::incremental_hull<T> back_hull;
+
+
+		csce::hull_chains<T> chains(const csce::incremental_hull<T>& hull) const {
+			csce::hull_chains<T> output;
+			output.lower.assign(hull.lower().begin(), hull.lower().end());
+			output.upper.assign(hull.upper().begin(), hull.upper().end());
+			return output;
+		}
+
+
+		double oldest() const {
+			return this->front.empty() ? this->back.front().timestamp : this->front.back().timestamp;
+		}
+
+
+		void pop() {
+			if(this->front.empty()){
+				//move the back stack over, newest point first, so that the oldest point is undone first
+				this->front.reserve(this->back.size());
+				for(std::size_t x=this->back.size(); x-- > 0; ){
+					entry current;
+					current.timestamp = this->back[x].timestamp;
+					this->front_hull.insert(this->back[x].p, current.inserted);
+					this->front.push_back(std::move(current));
+				}
+				this->back.clear();
+				this->back_hull.clear();
+			}
+			this->front_hull.undo(this->front.back().inserted);
+			this->front.pop_back();
+		}
+	};
+}
+
+#endif /* sliding_window_hull_hpp */
@@ -7,6 +7,7 @@
 #include <iterator>
 
 #include "point.hpp"
+#include "angular_sort.hpp"
 
 namespace csce {
 	template<typename T>
@@ -15,11 +16,7 @@ namespace csce {
 		sort(const csce::point<T>& pivot_point) : p(pivot_point) {}
 		
 		void sort_array(typename std::vector<csce::point<T>>::iterator begin, typename std::vector<csce::point<T>>::iterator end) {
-			std::sort(begin, end, [&](csce::point<T>& a, csce::point<T>& b) {
-                                csce::vector2d<T> pa(this->p, a);
-                                csce::vector2d<T> pb(this->p, b);
-                                return pa.ccw(pb);
-                        });
+			std::sort(begin, end, csce::angle_less<T>(this->p));
 		}
 		
 	private:
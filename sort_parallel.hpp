@@ -1,114 +1,116 @@
 #ifndef sort_parallel_hpp
 #define sort_parallel_hpp
 
-#include <thread>
-#include <cmath>
+#include <vector>
 #include <utility>
 #include <algorithm>
 #include <iterator>
 
 #include "point.hpp"
+#include "angular_sort.hpp"
+#include "executor.hpp"
+#include "scratch_arena.hpp"
 
 namespace csce {
-	template<typename T>
+	/**
+	 * A parallel merge sort. Every thread sorts one segment, and then the segments are merged
+	 * pairwise in rounds until one is left. Within a round the output is split evenly between the
+	 * threads regardless of which pair it belongs to: each thread finds where its part of the output
+	 * starts and ends in the two inputs with a binary search along the merge path (co-ranking) and
+	 * merges just that part. So every thread is busy in every round, and the total work is
+	 * O(n log n / p + n log p).
+	 *
+	 * The rounds alternate between the points and one scratch buffer, which the sorter keeps between
+	 * calls (in the arena, if it is given one). The segment sorts and every round run as tasks on
+	 * the executor.
+	 *
+	 * By default the points are ordered by angle around a pivot (see angle_less).
+	 */
+	template<typename T, typename Compare = csce::angle_less<T>>
 	class sort_parallel {
 	public:
-		sort_parallel(const csce::point<T>& pivot_point, int _nthreads) : p(pivot_point), nthreads(_nthreads) {}
-		
+		sort_parallel(const csce::point<T>& pivot_point, csce::executor& _pool, csce::scratch_arena* _arena = nullptr) : compare(pivot_point), pool(_pool), buffer(csce::arena_allocator<csce::point<T>>(_arena)) {}
+		sort_parallel(Compare _compare, csce::executor& _pool, csce::scratch_arena* _arena = nullptr) : compare(_compare), pool(_pool), buffer(csce::arena_allocator<csce::point<T>>(_arena)) {}
+
 		void sort_array(typename std::vector<csce::point<T>>::iterator begin, typename std::vector<csce::point<T>>::iterator end) {
-			std::pair<int, int>* indices = new std::pair<int, int>[nthreads];
-			std::thread* threads = new std::thread[nthreads]; //4 threads
-			int n = static_cast<int>(std::distance(begin, end));
-			int nelements = static_cast<int>(std::ceil(static_cast<double>(n) / static_cast<double>(this->nthreads)));
-			
-			int start = 0, stop = nelements;
-			
-			int segment_count = 0;
-			
-			//sort elements in each segment
-			for(int x=0; x<nthreads && start < n; x++, start += nelements, stop += nelements){
-				indices[x] = std::make_pair(start, std::min(stop, n));
-				threads[x] = std::thread(&csce::sort_parallel<T>::sort_thread, this, begin + indices[x].first, begin + indices[x].second);
-				segment_count++;
+			std::size_t n = static_cast<std::size_t>(std::distance(begin, end));
+			std::size_t segment_count = this->pool.chunk_count(n, minimum_segment);
+			if(segment_count == 1){
+				std::sort(begin, end, this->compare);
+				return;
 			}
-			for(int x=0; x<segment_count; x++) {
-				threads[x].join();
+
+			this->buffer.resize(n);
+			csce::scratch_vector<std::size_t> bounds(segment_count + 1, 0, this->buffer.get_allocator());
+			for(std::size_t x=0; x<=segment_count; x++){
+				bounds[x] = n * x / segment_count;
 			}
-			
-			if(segment_count < 2){
-				//no need to do an even-odd merge if there are not at least two segments to merge
-				return;
+
+			csce::point<T>* points = &*begin;
+			this->pool.fork_join(segment_count, [&](std::size_t segment) {
+				std::sort(points + bounds[segment], points + bounds[segment + 1], this->compare);
+			});
+
+			csce::point<T>* from = points;
+			csce::point<T>* to = this->buffer.data();
+			for(std::size_t width=1; width<segment_count; width*=2){
+				//every task writes the output range of one segment, whichever pair of runs it comes from
+				this->pool.fork_join(segment_count, [&](std::size_t segment) {
+					std::size_t low = bounds[segment];
+					std::size_t high = bounds[segment + 1];
+					for(std::size_t x=0; x<segment_count; x+=2*width){
+						std::size_t start = bounds[x];
+						std::size_t mid = bounds[std::min(x + width, segment_count)];
+						std::size_t stop = bounds[std::min(x + 2 * width, segment_count)];
+						if(stop <= low || start >= high){
+							continue;
+						}
+
+						std::size_t first = std::max(low, start) - start;
+						std::size_t last = std::min(high, stop) - start;
+						std::size_t a_first = this->co_rank(first, from + start, mid - start, from + mid, stop - mid);
+						std::size_t a_last = this->co_rank(last, from + start, mid - start, from + mid, stop - mid);
+						std::merge(from + start + a_first, from + start + a_last, from + mid + (first - a_first), from + mid + (last - a_last), to + start + first, this->compare);
+					}
+				});
+				std::swap(from, to);
 			}
-			
-			//now do even-odd merge
-			for(int start_index = 0, y=0; y<nthreads; start_index = (start_index + 1) % 2, y++){
-				int thread_count = 0;
-				for(int x=start_index, max = std::min(nthreads, segment_count) - 1; x < max; x+=2){
-					thread_count++;
-					threads[x>>1] = std::thread(&csce::sort_parallel<T>::merge_thread, this, begin + indices[x].first, begin + indices[x].second, begin + indices[x+1].second);
-				}
-				for(int x=0; x<thread_count; x++){
-					threads[x].join();
-				}
+
+			if(from != points){
+				this->pool.fork_join(segment_count, [&](std::size_t segment) {
+					std::copy(from + bounds[segment], from + bounds[segment + 1], points + bounds[segment]);
+				});
 			}
-			
-			delete[] threads;
-			delete[] indices;
 		}
-		
-		
+
+
 	private:
-		void sort_thread(typename std::vector<csce::point<T>>::iterator begin, typename std::vector<csce::point<T>>::iterator end) {
-			std::sort(begin, end, [&](csce::point<T>& a, csce::point<T>& b) {
-				csce::vector2d<T> pa(this->p, a);
-				csce::vector2d<T> pb(this->p, b);
-				return pa.ccw(pb);
-			});
-		}
-		
-		
-		void merge_thread(typename std::vector<csce::point<T>>::iterator begin, typename std::vector<csce::point<T>>::iterator mid, typename std::vector<csce::point<T>>::iterator end) {
-			auto n = std::distance(begin, end);
-			csce::point<T>* tmp = new csce::point<T>[n];
-			
-			typename std::vector<csce::point<T>>::iterator pa = begin;
-			typename std::vector<csce::point<T>>::iterator pb = mid;
-			int x = 0;
-			while(pa != mid && pb != end){
-				csce::point<T>& a = *pa;
-				csce::point<T>& b = *pb;
-				
-				csce::vector2d<T> va(this->p, a);
-				csce::vector2d<T> vb(this->p, b);
-				
-				if(va.ccw(vb)){
-					pa++;
-					tmp[x++] = a;
+		//below this many points per task, sorting on one thread is faster
+		static const std::size_t minimum_segment = 4096;
+
+
+		/**
+		 * The number of points from a in the first k points of the (stable) merge of a and b, by binary
+		 * search: a[i] is among them exactly when it does not come after b[k - 1 - i].
+		 */
+		std::size_t co_rank(std::size_t k, const csce::point<T>* a, std::size_t a_count, const csce::point<T>* b, std::size_t b_count) const {
+			std::size_t low = k > b_count ? k - b_count : 0;
+			std::size_t high = std::min(k, a_count);
+			while(low < high){
+				std::size_t i = low + (high - low) / 2;
+				if(this->compare(b[k - 1 - i], a[i])){
+					high = i;
 				} else {
-					pb++;
-					tmp[x++] = b;
+					low = i + 1;
 				}
 			}
-			
-			while(pa != mid){
-				tmp[x++] = *pa;
-				pa++;
-			}
-			
-			while(pb != end){
-				tmp[x++] = *pb;
-				pb++;
-			}
-			
-			std::copy(tmp, tmp + n, begin);
-			delete[] tmp;
+			return low;
 		}
-		
-		
-	private:
-		csce::point<T> p;
-		int nthreads;
-		
+
+
+		Compare compare;
+		csce::executor& pool;
+		csce::scratch_vector<csce::point<T>> buffer;
 	};
 }
 
@@ -0,0 +1,154 @@
+#ifndef streaming_hull_hpp
+#define streaming_hull_hpp
+
+#include <vector>
+#include <string>
+#include <sstream>
+#include <istream>
+#include <fstream>
+#include <iostream>
+#include <future>
+#include <algorithm>
+
+#include "point.hpp"
+#include "monotone_chain.hpp"
+#include "quick_hull_inplace.hpp"
+#include "point_file.hpp"
+
+namespace csce {
+	/**
+	 * Computes the convex hull of a stream of points that does not have to fit in memory.
+	 * The points are read in chunks of a fixed size, the hull of each chunk is computed with
+	 * U and folded into the running hull, and the chunk is thrown away. Memory use is the
+	 * running hull plus two chunk buffers: while one chunk's hull is being computed, the next
+	 * chunk is parsed into the other buffer on a separate thread. A binary point file is mapped
+	 * instead of parsed.
+	 */
+	template<typename T, typename U = csce::quick_hull_inplace<T>>
+	class streaming_hull {
+	public:
+		streaming_hull(int _nthreads, std::size_t _chunk_size = 1 << 20) : chunk_size(std::max<std::size_t>(1, _chunk_size)), algorithm(_nthreads) {}
+
+
+		/**
+		 * Returns the hull of the points in the file as a counterclockwise polygon starting at the
+		 * left-most point. A path of "-" reads from standard input.
+		 */
+		std::vector<csce::point<T>> compute_hull(const std::string& file_path) {
+			if(file_path == "-"){
+				return this->compute_hull(std::cin);
+			}
+			if(csce::point_file::detect(file_path)){
+				csce::point_file file(file_path);
+				return this->compute_hull(file);
+			}
+
+			std::ifstream file(file_path, std::ios::in);
+			if(!file.is_open()){
+				this->points_read = 0;
+				this->chunks_read = 0;
+				return std::vector<csce::point<T>>();
+			}
+			return this->compute_hull(file);
+		}
+
+
+		/**
+		 * Returns the hull of the whitespace separated "x y" pairs read from input until it ends.
+		 */
+		std::vector<csce::point<T>> compute_hull(std::istream& input) {
+			this->running_hull.clear();
+			this->points_read = 0;
+			this->chunks_read = 0;
+
+			std::vector<csce::point<T>> current;
+			std::vector<csce::point<T>> next;
+			this->read_chunk(input, current);
+			while(!current.empty()){
+				std::future<void> reader = std::async(std::launch::async, &csce::streaming_hull<T, U>::read_chunk, this, std::ref(input), std::ref(next));
+				this->fold(current);
+				reader.get();
+				current.swap(next);
+			}
+
+			return this->running_hull;
+		}
+
+
+		/**
+		 * Returns the hull of the points in a point file. The chunks are copied (or decoded, block by
+		 * block) out of the mapping, so only the pages of the current chunk have to be in memory.
+		 */
+		std::vector<csce::point<T>> compute_hull(const csce::point_file& file) {
+			this->running_hull.clear();
+			this->points_read = 0;
+			this->chunks_read = 0;
+
+			std::vector<csce::point<T>> chunk;
+			chunk.reserve(std::min(this->chunk_size, file.size()));
+			for(std::size_t start=0; start<file.size(); start+=this->chunk_size){
+				std::size_t stop = std::min(file.size(), start + this->chunk_size);
+				chunk.clear();
+				file.copy(start, stop, chunk);
+				this->fold(chunk);
+			}
+
+			return this->running_hull;
+		}
+
+
+		/**
+		 * The number of points read by the last call to compute_hull.
+		 */
+		std::size_t count() const {
+			return this->points_read;
+		}
+
+
+		std::string summary() const {
+			std::stringstream output;
+			output << "streamed " << this->points_read << " points in " << this->chunks_read << " chunks";
+			return output.str();
+		}
+
+
+	private:
+		std::size_t chunk_size;
+		std::size_t points_read = 0;
+		std::size_t chunks_read = 0;
+		std::vector<csce::point<T>> running_hull;
+		U algorithm;
+
+
+		/**
+		 * Replaces the contents of chunk with up to chunk_size points from input.
+		 */
+		void read_chunk(std::istream& input, std::vector<csce::point<T>>& chunk) {
+			chunk.clear();
+			chunk.reserve(this->chunk_size);
+			T x = 0, y = 0;
+			while(chunk.size() < this->chunk_size && input >> x >> y){
+				chunk.push_back(csce::point<T>(x, y));
+			}
+		}
+
+
+		/**
+		 * Replaces the running hull with the hull of the running hull and the chunk's points.
+		 */
+		void fold(std::vector<csce::point<T>>& chunk) {
+			this->points_read += chunk.size();
+			this->chunks_read++;
+
+			std::vector<csce::point<T>> points = this->algorithm.compute_hull(chunk);
+			points.insert(points.end(), this->running_hull.begin(), this->running_hull.end());
+			std::sort(points.begin(), points.end(), csce::monotone_chain<T>::lexicographic_less);
+
+			std::vector<csce::point<T>> lower = csce::monotone_chain<T>::lower_chain(points.begin(), points.end());
+			std::vector<csce::point<T>> upper = csce::monotone_chain<T>::upper_chain(points.begin(), points.end());
+			this->running_hull = csce::monotone_chain<T>::join_chains(lower, upper);
+		}
+	};
+}
+
+#endif /* streaming_hull_hpp */
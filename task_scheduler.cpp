@@ -0,0 +1,115 @@
+#include "task_scheduler.hpp"
+
+#include <chrono>
+
+thread_local csce::task_scheduler* csce::task_scheduler::current_scheduler = nullptr;
+thread_local std::size_t csce::task_scheduler::current_queue = 0;
+
+csce::task_scheduler::task_scheduler(int nthreads) : stopping(false), queued(0) {
+	std::size_t worker_count = nthreads > 1 ? static_cast<std::size_t>(nthreads - 1) : 0;
+	for(std::size_t x=0; x<=worker_count; x++){
+		this->queues.push_back(std::unique_ptr<task_queue>(new task_queue()));
+	}
+	for(std::size_t x=1; x<=worker_count; x++){
+		this->workers.push_back(std::thread(&csce::task_scheduler::worker_loop, this, x));
+	}
+}
+
+csce::task_scheduler::~task_scheduler() {
+	{
+		std::lock_guard<std::mutex> lock(this->sleep_mutex);
+		this->stopping = true;
+	}
+	this->wake.notify_all();
+	for(auto& worker : this->workers){
+		worker.join();
+	}
+}
+
+void csce::task_scheduler::spawn(task_group& group, std::function<void()> function) {
+	add_task(group);
+
+	task_queue& queue = *this->queues[this->queue_index()];
+	{
+		std::lock_guard<std::mutex> lock(queue.mutex);
+		queue.tasks.push_back(task{std::move(function), &group});
+	}
+
+	this->queued.fetch_add(1, std::memory_order_release);
+	if(!this->workers.empty()){
+		std::lock_guard<std::mutex> lock(this->sleep_mutex);
+		this->wake.notify_one();
+	}
+}
+
+void csce::task_scheduler::wait(task_group& group) {
+	std::size_t index = this->queue_index();
+	while(!group.done()){
+		if(!this->run_one(index)){
+			std::this_thread::yield(); //the remaining tasks of the group are running on other workers
+		}
+	}
+	rethrow(group);
+}
+
+int csce::task_scheduler::concurrency() const {
+	return static_cast<int>(this->workers.size() + 1);
+}
+
+void csce::task_scheduler::worker_loop(std::size_t index) {
+	current_scheduler = this;
+	current_queue = index;
+
+	while(!this->stopping.load(std::memory_order_acquire)){
+		if(!this->run_one(index)){
+			std::unique_lock<std::mutex> lock(this->sleep_mutex);
+			this->wake.wait_for(lock, std::chrono::milliseconds(1), [this]() {
+				return this->stopping.load(std::memory_order_acquire) || this->queued.load(std::memory_order_acquire) > 0;
+			});
+		}
+	}
+
+	current_scheduler = nullptr;
+}
+
+std::size_t csce::task_scheduler::queue_index() const {
+	return current_scheduler == this ? current_queue : 0;
+}
+
+bool csce::task_scheduler::run_one(std::size_t index) {
+	task next;
+	if(!this->pop(index, next) && !this->steal(index, next)){
+		return false;
+	}
+
+	run_task(*next.group, next.function);
+	return true;
+}
+
+bool csce::task_scheduler::pop(std::size_t index, task& output) {
+	task_queue& queue = *this->queues[index];
+	std::lock_guard<std::mutex> lock(queue.mutex);
+	if(queue.tasks.empty()){
+		return false;
+	}
+
+	output = std::move(queue.tasks.back());
+	queue.tasks.pop_back();
+	this->queued.fetch_sub(1, std::memory_order_relaxed);
+	return true;
+}
+
+bool csce::task_scheduler::steal(std::size_t thief, task& output) {
+	std::size_t count = this->queues.size();
+	for(std::size_t offset=1; offset<count; offset++){
+		task_queue& queue = *this->queues[(thief + offset) % count];
+		std::lock_guard<std::mutex> lock(queue.mutex);
+		if(!queue.tasks.empty()){
+			output = std::move(queue.tasks.front());
+			queue.tasks.pop_front();
+			this->queued.fetch_sub(1, std::memory_order_relaxed);
+			return true;
+		}
+	}
+	return false;
+}
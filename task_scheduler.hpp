@@ -0,0 +1,87 @@
+#ifndef task_scheduler_hpp
+#define task_scheduler_hpp
+
+#include <vector>
+#include <deque>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <functional>
+#include <memory>
+
+#include "executor.hpp"
+
+namespace csce {
+	/**
+	 * A work-stealing task scheduler. Every worker owns a deque of tasks: it pushes and pops
+	 * its own tasks at the back, and idle workers steal from the front of the other deques.
+	 * Tasks are grouped into task_groups so that a task can fork children and wait for them
+	 * to finish. A thread waiting on a group keeps running tasks instead of blocking, so
+	 * recursive fork/join does not deadlock.
+	 *
+	 * It is the thread pool behind shared_executor.
+	 */
+	class task_scheduler : public csce::executor {
+	public:
+		/**
+		 * Starts nthreads - 1 worker threads. The thread calling wait() is the remaining worker.
+		 */
+		task_scheduler(int nthreads);
+		~task_scheduler();
+
+		task_scheduler(const task_scheduler&) = delete;
+		task_scheduler& operator=(const task_scheduler&) = delete;
+
+
+		/**
+		 * Queues a task as part of the group. Tasks spawned from a worker go on that worker's
+		 * deque, where it will run them last-in-first-out unless they are stolen first.
+		 */
+		void spawn(task_group& group, std::function<void()> task);
+
+
+		/**
+		 * Runs queued tasks until every task in the group has finished, and then rethrows the first
+		 * exception that a task of the group threw.
+		 */
+		void wait(task_group& group);
+
+
+		/**
+		 * The number of threads, including the calling thread, that execute tasks.
+		 */
+		int concurrency() const;
+
+
+	private:
+		struct task {
+			std::function<void()> function;
+			task_group* group;
+		};
+
+		struct task_queue {
+			std::mutex mutex;
+			std::deque<task> tasks;
+		};
+
+		//queue 0 is shared by threads that are not workers of this scheduler
+		std::vector<std::unique_ptr<task_queue>> queues;
+		std::vector<std::thread> workers;
+		std::atomic<bool> stopping;
+		std::atomic<std::size_t> queued;
+		std::mutex sleep_mutex;
+		std::condition_variable wake;
+
+		static thread_local task_scheduler* current_scheduler;
+		static thread_local std::size_t current_queue;
+
+		void worker_loop(std::size_t index);
+		std::size_t queue_index() const;
+		bool run_one(std::size_t index);
+		bool pop(std::size_t index, task& output);
+		bool steal(std::size_t thief, task& output);
+	};
+}
+
+#endif /* task_scheduler_hpp */
@@ -6,6 +6,25 @@ bool csce::test::run() const {
 	correct &= this->test_convex_polygon();
 	correct &= this->test_contains_all_points();
 	correct &= this->test_validate_convex_hull();
+	correct &= this->test_hull_merge();
+	correct &= this->test_incremental_hull();
+	correct &= this->test_dynamic_hull();
+	correct &= this->test_streaming_hull();
+	correct &= this->test_sliding_window_hull();
+	correct &= this->test_directional_coreset();
+	correct &= this->test_batch_hulls();
+	correct &= this->test_exact_orientation();
+	correct &= this->test_robust_orientation();
+	correct &= this->test_orientation_kernels();
+	correct &= this->test_point_cloud();
+	correct &= this->test_angular_sort();
+	correct &= this->test_sort_parallel();
+	correct &= this->test_executor();
+	correct &= this->test_scratch_arena();
+	correct &= this->test_graham_scan();
+	correct &= this->test_point_span();
+	correct &= this->test_point_file();
+	correct &= this->test_text_loader();
 	
 	std::cout << "tests complete ... " << (correct ? "correct" : "INCORRECT") << std::endl;
 	return correct;
@@ -867,3 +886,1586 @@ bool csce::test::test_validate_convex_hull() const {
 	std::cout << (correct ? "correct" : "INCORRECT") << std::endl;
 	return correct;
 }
+
+
+bool csce::test::test_hull_merge() const {
+	bool correct = true;
+	
+	std::cout << "Testing hull merge ... " << std::flush;
+	if(this->debug){
+		std::cout << std::endl;
+	}
+	
+	{
+		//two squares side by side, the inner corners are dropped by the bridges
+		std::vector<csce::point<int>> left;
+		left.push_back(csce::point<int>(0, 0));
+		left.push_back(csce::point<int>(0, 10));
+		left.push_back(csce::point<int>(10, 0));
+		left.push_back(csce::point<int>(10, 10));
+		
+		std::vector<csce::point<int>> right;
+		right.push_back(csce::point<int>(20, 2));
+		right.push_back(csce::point<int>(20, 8));
+		right.push_back(csce::point<int>(30, -5));
+		right.push_back(csce::point<int>(30, 15));
+		
+		csce::hull_chains<int> merged = csce::hull_merge::merge(csce::hull_merge::from_sorted<int>(left.begin(), left.end()), csce::hull_merge::from_sorted<int>(right.begin(), right.end()));
+		std::vector<csce::point<int>> polygon = csce::hull_merge::to_polygon(merged);
+		
+		std::vector<csce::point<int>> expected_result;
+		expected_result.push_back(csce::point<int>(0, 0));
+		expected_result.push_back(csce::point<int>(30, -5));
+		expected_result.push_back(csce::point<int>(30, 15));
+		expected_result.push_back(csce::point<int>(0, 10));
+		
+		correct &= (polygon == expected_result);
+		if(this->debug){
+			for(auto& point : polygon){
+				std::cout << point.str() << " ";
+			}
+			std::cout << (polygon == expected_result ? "correct" : "INCORRECT") << std::endl;
+		}
+	}
+	
+	{
+		//the bridge passes through a collinear point, which must not be part of the hull
+		std::vector<csce::point<int>> left;
+		left.push_back(csce::point<int>(0, 0));
+		left.push_back(csce::point<int>(5, 5));
+		
+		std::vector<csce::point<int>> right;
+		right.push_back(csce::point<int>(10, 10));
+		right.push_back(csce::point<int>(10, 0));
+		std::sort(right.begin(), right.end(), csce::monotone_chain<int>::lexicographic_less);
+		
+		csce::hull_chains<int> merged = csce::hull_merge::merge(csce::hull_merge::from_sorted<int>(left.begin(), left.end()), csce::hull_merge::from_sorted<int>(right.begin(), right.end()));
+		std::vector<csce::point<int>> polygon = csce::hull_merge::to_polygon(merged);
+		
+		std::vector<csce::point<int>> expected_result;
+		expected_result.push_back(csce::point<int>(0, 0));
+		expected_result.push_back(csce::point<int>(10, 0));
+		expected_result.push_back(csce::point<int>(10, 10));
+		
+		correct &= (polygon == expected_result);
+		if(this->debug){
+			for(auto& point : polygon){
+				std::cout << point.str() << " ";
+			}
+			std::cout << (polygon == expected_result ? "correct" : "INCORRECT") << std::endl;
+		}
+	}
+	
+	std::cout << (correct ? "correct" : "INCORRECT") << std::endl;
+	return correct;
+}
+
+bool csce::test::test_incremental_hull() const {
+	bool correct = true;
+	
+	std::cout << "Testing incremental hull ... " << std::flush;
+	if(this->debug){
+		std::cout << std::endl;
+	}
+	
+	{
+		//a triangle grows into a square, interior and collinear points never change the hull
+		csce::incremental_hull<int> hull;
+		correct &= hull.insert(csce::point<int>(0, 0));
+		correct &= hull.insert(csce::point<int>(10, 0));
+		correct &= hull.insert(csce::point<int>(0, 10));
+		correct &= !hull.insert(csce::point<int>(2, 2));
+		correct &= !hull.insert(csce::point<int>(5, 0));
+		correct &= hull.insert(csce::point<int>(10, 10));
+		correct &= !hull.insert(csce::point<int>(5, 10));
+		correct &= hull.contains(csce::point<int>(10, 5));
+		correct &= !hull.contains(csce::point<int>(11, 5));
+		
+		std::vector<csce::point<int>> polygon = hull.hull();
+		
+		std::vector<csce::point<int>> expected_result;
+		expected_result.push_back(csce::point<int>(0, 0));
+		expected_result.push_back(csce::point<int>(10, 0));
+		expected_result.push_back(csce::point<int>(10, 10));
+		expected_result.push_back(csce::point<int>(0, 10));
+		
+		correct &= (polygon == expected_result);
+		if(this->debug){
+			for(auto& point : polygon){
+				std::cout << point.str() << " ";
+			}
+			std::cout << (polygon == expected_result ? "correct" : "INCORRECT") << std::endl;
+		}
+	}
+	
+	{
+		//a far away point swallows most of the hull
+		csce::incremental_hull<int> hull;
+		hull.insert(csce::point<int>(0, 0));
+		hull.insert(csce::point<int>(4, -1));
+		hull.insert(csce::point<int>(6, 2));
+		hull.insert(csce::point<int>(3, 5));
+		hull.insert(csce::point<int>(-1, 3));
+		hull.insert(csce::point<int>(3, 100));
+		
+		std::vector<csce::point<int>> polygon = hull.hull();
+		
+		std::vector<csce::point<int>> expected_result;
+		expected_result.push_back(csce::point<int>(-1, 3));
+		expected_result.push_back(csce::point<int>(0, 0));
+		expected_result.push_back(csce::point<int>(4, -1));
+		expected_result.push_back(csce::point<int>(6, 2));
+		expected_result.push_back(csce::point<int>(3, 100));
+		
+		correct &= (polygon == expected_result && hull.size() == expected_result.size());
+		if(this->debug){
+			for(auto& point : polygon){
+				std::cout << point.str() << " ";
+			}
+			std::cout << (polygon == expected_result ? "correct" : "INCORRECT") << std::endl;
+		}
+	}
+	
+	std::cout << (correct ? "correct" : "INCORRECT") << std::endl;
+	return correct;
+}
+
+bool csce::test::test_dynamic_hull() const {
+	bool correct = true;
+	
+	std::cout << "Testing dynamic hull ... " << std::flush;
+	if(this->debug){
+		std::cout << std::endl;
+	}
+	
+	{
+		//erasing a corner brings back the points it was hiding
+		std::vector<csce::point<int>> points;
+		points.push_back(csce::point<int>(0, 0));
+		points.push_back(csce::point<int>(10, 0));
+		points.push_back(csce::point<int>(10, 10));
+		points.push_back(csce::point<int>(0, 10));
+		points.push_back(csce::point<int>(8, 8));
+		points.push_back(csce::point<int>(5, 5));
+		csce::dynamic_hull<int> hull(points.begin(), points.end());
+		
+		correct &= hull.erase(csce::point<int>(10, 10));
+		correct &= !hull.erase(csce::point<int>(10, 10));
+		
+		std::vector<csce::point<int>> polygon = hull.hull();
+		
+		std::vector<csce::point<int>> expected_result;
+		expected_result.push_back(csce::point<int>(0, 0));
+		expected_result.push_back(csce::point<int>(10, 0));
+		expected_result.push_back(csce::point<int>(8, 8));
+		expected_result.push_back(csce::point<int>(0, 10));
+		
+		correct &= (polygon == expected_result && hull.size() == 5);
+		if(this->debug){
+			for(auto& point : polygon){
+				std::cout << point.str() << " ";
+			}
+			std::cout << (polygon == expected_result ? "correct" : "INCORRECT") << std::endl;
+		}
+	}
+	
+	{
+		//a batch that inserts a point twice and erases one copy keeps the point
+		std::vector<csce::point<int>> insertions;
+		insertions.push_back(csce::point<int>(0, 0));
+		insertions.push_back(csce::point<int>(4, 0));
+		insertions.push_back(csce::point<int>(2, 3));
+		insertions.push_back(csce::point<int>(2, 3));
+		insertions.push_back(csce::point<int>(2, 1));
+		
+		std::vector<csce::point<int>> erasures;
+		erasures.push_back(csce::point<int>(2, 3));
+		erasures.push_back(csce::point<int>(7, 7));
+		
+		csce::dynamic_hull<int> hull;
+		std::size_t erased = hull.update(insertions.begin(), insertions.end(), erasures.begin(), erasures.end());
+		
+		std::vector<csce::point<int>> polygon = hull.hull();
+		
+		std::vector<csce::point<int>> expected_result;
+		expected_result.push_back(csce::point<int>(0, 0));
+		expected_result.push_back(csce::point<int>(4, 0));
+		expected_result.push_back(csce::point<int>(2, 3));
+		
+		correct &= (polygon == expected_result && erased == 1);
+		if(this->debug){
+			for(auto& point : polygon){
+				std::cout << point.str() << " ";
+			}
+			std::cout << (polygon == expected_result ? "correct" : "INCORRECT") << std::endl;
+		}
+	}
+	
+	std::cout << (correct ? "correct" : "INCORRECT") << std::endl;
+	return correct;
+}
+
+bool csce::test::test_streaming_hull() const {
+	bool correct = true;
+	
+	std::cout << "Testing streaming hull ... " << std::flush;
+	if(this->debug){
+		std::cout << std::endl;
+	}
+	
+	{
+		//chunks of two points, so the corners are spread over several folds
+		std::stringstream input("5 5\n0 0\n10 0\n3 4\n10 10\n7 2\n0 10\n");
+		csce::streaming_hull<int> streaming(1, 2);
+		std::vector<csce::point<int>> polygon = streaming.compute_hull(input);
+		
+		std::vector<csce::point<int>> expected_result;
+		expected_result.push_back(csce::point<int>(0, 0));
+		expected_result.push_back(csce::point<int>(10, 0));
+		expected_result.push_back(csce::point<int>(10, 10));
+		expected_result.push_back(csce::point<int>(0, 10));
+		
+		correct &= (polygon == expected_result && streaming.count() == 7);
+		if(this->debug){
+			for(auto& point : polygon){
+				std::cout << point.str() << " ";
+			}
+			std::cout << (polygon == expected_result ? "correct" : "INCORRECT") << std::endl;
+		}
+	}
+	
+	std::cout << (correct ? "correct" : "INCORRECT") << std::endl;
+	return correct;
+}
+
+bool csce::test::test_sliding_window_hull() const {
+	bool correct = true;
+	
+	std::cout << "Testing sliding window hull ... " << std::flush;
+	if(this->debug){
+		std::cout << std::endl;
+	}
+	
+	{
+		//a window of the last 3 seconds, so the first two points expire by the last step
+		csce::sliding_window_hull<int> window(100, 3);
+		window.push(0, csce::point<int>(0, 0));
+		window.push(1, csce::point<int>(20, 0));
+		window.push(2, csce::point<int>(5, 5));
+		window.push(3, csce::point<int>(10, 0));
+		window.push(4, csce::point<int>(5, -5));
+		
+		std::vector<csce::point<int>> polygon = window.hull();
+		
+		std::vector<csce::point<int>> expected_result;
+		expected_result.push_back(csce::point<int>(5, -5));
+		expected_result.push_back(csce::point<int>(10, 0));
+		expected_result.push_back(csce::point<int>(5, 5));
+		
+		correct &= (polygon == expected_result && window.size() == 3);
+		if(this->debug){
+			for(auto& point : polygon){
+				std::cout << point.str() << " ";
+			}
+			std::cout << (polygon == expected_result ? "correct" : "INCORRECT") << std::endl;
+		}
+	}
+	
+	{
+		//every step of a long stream through a small window gives the hull of exactly the points in the window
+		std::vector<csce::point<long long>> stream = csce::utility::random_points<long long>(5000, -50, 50);
+		csce::sliding_window_hull<long long> window(300);
+		csce::monotone_chain<long long> algorithm(1);
+		
+		bool result = true;
+		for(std::size_t x=0; x<stream.size(); x++){
+			window.push(static_cast<double>(x), stream[x]);
+			if(x % 37 == 0 || x + 1 == stream.size()){
+				std::vector<csce::point<long long>> points(stream.begin() + (x < 300 ? 0 : x - 299), stream.begin() + x + 1);
+				result &= (window.hull() == algorithm.compute_hull(points) && window.size() == points.size());
+			}
+		}
+		correct &= result;
+		if(this->debug){
+			std::cout << (result ? "correct" : "INCORRECT") << std::endl;
+		}
+	}
+	
+	std::cout << (correct ? "correct" : "INCORRECT") << std::endl;
+	return correct;
+}
+
+bool csce::test::test_directional_coreset() const {
+	bool correct = true;
+	
+	std::cout << "Testing directional coreset ... " << std::flush;
+	if(this->debug){
+		std::cout << std::endl;
+	}
+	
+	{
+		//two shards of a square, merged. The corners are extreme in the diagonal directions, so the hull is exact.
+		csce::directional_coreset<int> left(8);
+		left.add(csce::point<int>(0, 0));
+		left.add(csce::point<int>(0, 10));
+		left.add(csce::point<int>(3, 4));
+		
+		csce::directional_coreset<int> right(8);
+		right.add(csce::point<int>(10, 0));
+		right.add(csce::point<int>(10, 10));
+		right.add(csce::point<int>(7, 6));
+		
+		left.merge(right);
+		std::vector<csce::point<int>> polygon = left.hull();
+		
+		std::vector<csce::point<int>> expected_result;
+		expected_result.push_back(csce::point<int>(0, 0));
+		expected_result.push_back(csce::point<int>(10, 0));
+		expected_result.push_back(csce::point<int>(10, 10));
+		expected_result.push_back(csce::point<int>(0, 10));
+		
+		correct &= (polygon == expected_result && left.error_bound() < 1E-9);
+		if(this->debug){
+			for(auto& point : polygon){
+				std::cout << point.str() << " ";
+			}
+			std::cout << "(error bound " << left.error_bound() << ") ";
+			std::cout << (polygon == expected_result ? "correct" : "INCORRECT") << std::endl;
+		}
+	}
+	
+	std::cout << (correct ? "correct" : "INCORRECT") << std::endl;
+	return correct;
+}
+
+bool csce::test::test_batch_hulls() const {
+	bool correct = true;
+	
+	std::cout << "Testing batch hulls ... " << std::flush;
+	if(this->debug){
+		std::cout << std::endl;
+	}
+	
+	{
+		//a square with an inside point, an empty set, and a set of one repeated point
+		std::vector<csce::point<int>> square;
+		square.push_back(csce::point<int>(4, 4));
+		square.push_back(csce::point<int>(0, 0));
+		square.push_back(csce::point<int>(0, 4));
+		square.push_back(csce::point<int>(2, 1));
+		square.push_back(csce::point<int>(4, 0));
+		
+		std::vector<csce::point<int>> repeated(3, csce::point<int>(7, 7));
+		
+		csce::point_batch<int> input;
+		input.push_back(square.begin(), square.end());
+		input.push_back(square.end(), square.end());
+		input.push_back(repeated.begin(), repeated.end());
+		csce::point_batch<int> output = csce::batch_hulls<int>(2).compute_hulls(input);
+		
+		std::vector<csce::point<int>> expected_result;
+		expected_result.push_back(csce::point<int>(0, 0));
+		expected_result.push_back(csce::point<int>(4, 0));
+		expected_result.push_back(csce::point<int>(4, 4));
+		expected_result.push_back(csce::point<int>(0, 4));
+		expected_result.push_back(csce::point<int>(7, 7));
+		
+		std::vector<std::size_t> expected_offsets;
+		expected_offsets.push_back(0);
+		expected_offsets.push_back(4);
+		expected_offsets.push_back(4);
+		expected_offsets.push_back(5);
+		
+		correct &= (output.points == expected_result && output.offsets == expected_offsets);
+		if(this->debug){
+			for(auto& point : output.points){
+				std::cout << point.str() << " ";
+			}
+			std::cout << (output.points == expected_result ? "correct" : "INCORRECT") << std::endl;
+		}
+	}
+	
+	std::cout << (correct ? "correct" : "INCORRECT") << std::endl;
+	return correct;
+}
+
+bool csce::test::test_exact_orientation() const {
+	bool correct = true;
+	
+	std::cout << "Testing exact orientation ... " << std::flush;
+	if(this->debug){
+		std::cout << std::endl;
+	}
+	
+	{
+		//the cross products are around 2^60, which overflows 32-bit arithmetic but not the widened 64-bit one
+		csce::point<int> o(-(1 << 29), -(1 << 29));
+		csce::point<int> a((1 << 29) + 1, (1 << 29));
+		csce::point<int> b((1 << 29), (1 << 29) + 1);
+		csce::point<int> c((1 << 29) - 1, (1 << 29) - 1);
+		
+		std::vector<int> turns;
+		turns.push_back(csce::orientation::turn(o, a, b));
+		turns.push_back(csce::orientation::turn(o, b, a));
+		turns.push_back(csce::orientation::turn(o, a, c));
+		turns.push_back(csce::vector2d<int>(o, c).orientation(csce::vector2d<int>(o, csce::point<int>(0, 0))));
+		
+		std::vector<int> expected_result;
+		expected_result.push_back(1);
+		expected_result.push_back(-1);
+		expected_result.push_back(1);
+		expected_result.push_back(0);
+		
+		correct &= (turns == expected_result);
+		if(this->debug){
+			for(auto& turn : turns){
+				std::cout << turn << " ";
+			}
+			std::cout << (turns == expected_result ? "correct" : "INCORRECT") << std::endl;
+		}
+	}
+	
+	{
+		//64-bit coordinates near 2^61 are widened to 128 bits, and a difference of one unit still counts
+		long long int big = 1LL << 61;
+		csce::point<long long int> o(-big, -big);
+		csce::point<long long int> a(big, big);
+		csce::point<long long int> b(big - 1, big);
+		
+		int turn = csce::orientation::turn(o, a, b);
+		int collinear = csce::orientation::turn(o, a, csce::point<long long int>(0, 0));
+		
+		correct &= (turn == 1 && collinear == 0);
+		if(this->debug){
+			std::cout << turn << " " << collinear << " " << ((turn == 1 && collinear == 0) ? "correct" : "INCORRECT") << std::endl;
+		}
+	}
+	
+	{
+		//x + y of these points crosses 2^63, but the octagon of Akl-Toussaint is still found with the widened sums
+		long long int big = 1LL << 61;
+		std::mt19937_64 generator(5);
+		std::uniform_int_distribution<long long int> coordinate(big, 3 * big);
+		std::vector<csce::point<long long int>> points;
+		for(int x=0; x<2000; x++){
+			points.push_back(csce::point<long long int>(coordinate(generator), coordinate(generator)));
+		}
+		
+		std::vector<csce::point<long long int>> points_copy = points;
+		std::vector<csce::point<long long int>> expected = csce::monotone_chain<long long int>(1).compute_hull(points_copy);
+		csce::akl_toussaint<long long int, csce::monotone_chain<long long int>> algorithm(1);
+		points_copy = points;
+		std::vector<csce::point<long long int>> hull = algorithm.compute_hull(points_copy);
+		
+		bool result = (hull == expected && algorithm.filter(points).size() < points.size());
+		correct &= result;
+		if(this->debug){
+			std::cout << (result ? "correct" : "INCORRECT") << std::endl;
+		}
+	}
+	
+	std::cout << (correct ? "correct" : "INCORRECT") << std::endl;
+	return correct;
+}
+
+bool csce::test::test_robust_orientation() const {
+	bool correct = true;
+	
+	std::cout << "Testing robust orientation ... " << std::flush;
+	if(this->debug){
+		std::cout << std::endl;
+	}
+	
+	{
+		//a grid of points one ulp apart around (0.5, 0.5), against the line y = x through (12, 12) and (24, 24):
+		//the exact turn is the sign of j - i, which plain double arithmetic gets wrong for many of them
+		double ulp = std::ldexp(1.0, -53);
+		csce::point<double> q(12, 12);
+		csce::point<double> r(24, 24);
+		int wrong = 0;
+		for(int i=0; i<64; i++){
+			for(int j=0; j<64; j++){
+				csce::point<double> p(0.5 + i * ulp, 0.5 + j * ulp);
+				int expected = (j > i) - (j < i);
+				wrong += (csce::orientation::turn(p, q, r) != expected);
+				wrong += (csce::vector2d<double>(q, r).orientation(csce::vector2d<double>(q, p)) != expected);
+			}
+		}
+		
+		correct &= (wrong == 0);
+		if(this->debug){
+			std::cout << wrong << " wrong turns " << (wrong == 0 ? "correct" : "INCORRECT") << std::endl;
+		}
+	}
+	
+	{
+		//collinearity does not depend on the scale of the coordinates, which an absolute epsilon does
+		csce::point<double> o(0, 0);
+		int small = csce::orientation::turn(o, csce::point<double>(1E-6, 0), csce::point<double>(0, 1E-6));
+		int large = csce::orientation::turn(o, csce::point<double>(1, 3), csce::point<double>(1E20, 3E20));
+		
+		bool result = (small == 1 && large == 0);
+		correct &= result;
+		if(this->debug){
+			std::cout << small << " " << large << " " << (result ? "correct" : "INCORRECT") << std::endl;
+		}
+	}
+	
+	{
+		//random points almost never need more than the fast path
+		std::vector<csce::point<double>> points = csce::utility::random_points<double>(30000, -100, 100);
+		unsigned long long int before = csce::robust_predicates::slow_path_count();
+		for(std::size_t x=0; x+2<points.size(); x++){
+			csce::orientation::turn(points[x], points[x+1], points[x+2]);
+		}
+		unsigned long long int slow = csce::robust_predicates::slow_path_count() - before;
+		
+		correct &= (slow * 1000 < points.size());
+		if(this->debug){
+			std::cout << slow << " of " << points.size() << " calls took the slow path " << (slow * 1000 < points.size() ? "correct" : "INCORRECT") << std::endl;
+		}
+	}
+	
+	std::cout << (correct ? "correct" : "INCORRECT") << std::endl;
+	return correct;
+}
+
+bool csce::test::test_orientation_kernels() const {
+	bool correct = true;
+	
+	std::cout << "Testing orientation kernels ... " << std::flush;
+	if(this->debug){
+		std::cout << std::endl;
+	}
+	
+	//points one ulp apart around the line y = x, plus random ones, in a count that leaves a tail after the vector lanes
+	double ulp = std::ldexp(1.0, -53);
+	csce::point<double> a(12, 12);
+	csce::point<double> b(24, 24);
+	std::vector<csce::point<double>> points = csce::utility::random_points<double>(1000, -100, 100);
+	for(int i=0; i<12; i++){
+		for(int j=0; j<12; j++){
+			points.push_back(csce::point<double>(0.5 + i * ulp, 0.5 + j * ulp));
+		}
+	}
+	points.push_back(csce::point<double>(36, 36));
+	std::vector<double> xs, ys;
+	for(auto& p : points){
+		xs.push_back(p.x);
+		ys.push_back(p.y);
+	}
+	std::size_t words = (points.size() + 63) / 64;
+	
+	csce::orientation_kernels::isa active = csce::orientation_kernels::active();
+	for(auto variant : csce::orientation_kernels::variants()){
+		csce::orientation_kernels::select(variant);
+		bool result = true;
+		for(int side=-1; side<=1; side++){
+			std::size_t expected_count = 0;
+			std::size_t expected_first = points.size();
+			std::vector<std::uint64_t> expected_bits(words);
+			for(std::size_t x=0; x<points.size(); x++){
+				if(csce::orientation::turn(a, b, points[x]) == side){
+					expected_count++;
+					expected_first = std::min(expected_first, x);
+					expected_bits[x / 64] |= std::uint64_t(1) << (x % 64);
+				}
+			}
+			
+			std::vector<std::uint64_t> bits(words), separate_bits(words), not_bits(words), separate_not_bits(words);
+			csce::orientation_kernels::mark(points.data(), points.size(), a, b, side, bits.data());
+			csce::orientation_kernels::mark(xs.data(), ys.data(), points.size(), a, b, side, separate_bits.data());
+			csce::orientation_kernels::mark_not(points.data(), points.size(), a, b, side, not_bits.data());
+			csce::orientation_kernels::mark_not(xs.data(), ys.data(), points.size(), a, b, side, separate_not_bits.data());
+			for(std::size_t x=0; x<points.size(); x++){
+				bool marked = (expected_bits[x / 64] >> (x % 64)) & 1;
+				result &= (((not_bits[x / 64] >> (x % 64)) & 1) != marked);
+				result &= (((separate_not_bits[x / 64] >> (x % 64)) & 1) != marked);
+			}
+			result &= (not_bits.back() >> (points.size() % 64) == 0 && separate_not_bits.back() >> (points.size() % 64) == 0); //nothing past the last point
+			result &= (csce::orientation_kernels::count(points.data(), points.size(), a, b, side) == expected_count);
+			result &= (csce::orientation_kernels::count(xs.data(), ys.data(), points.size(), a, b, side) == expected_count);
+			result &= (csce::orientation_kernels::find(points.data(), points.size(), a, b, side) == expected_first);
+			result &= (csce::orientation_kernels::find(xs.data(), ys.data(), points.size(), a, b, side) == expected_first);
+			result &= (bits == expected_bits && separate_bits == expected_bits);
+		}
+		
+		//points on the line all have zero area, and the tie goes to the first of the ones farthest along it
+		std::vector<csce::point<double>> on_line;
+		for(int x=0; x<11; x++){
+			on_line.push_back(csce::point<double>((x * 7) % 11, (x * 7) % 11));
+		}
+		on_line.push_back(on_line[3]);
+		result &= (csce::orientation_kernels::farthest(on_line.data(), on_line.size(), a, b) == 3);
+		
+		csce::point<double> corner(1000, -1000);
+		result &= (csce::orientation_kernels::farthest(xs.data(), ys.data(), points.size(), b, corner) == csce::orientation_kernels::farthest<double>(points.data(), points.size(), b, corner));
+		
+		correct &= result;
+		if(this->debug){
+			std::cout << csce::orientation_kernels::name(variant) << " " << (result ? "correct" : "INCORRECT") << std::endl;
+		}
+	}
+	csce::orientation_kernels::select(active);
+	
+	std::cout << (correct ? "correct" : "INCORRECT") << std::endl;
+	return correct;
+}
+
+bool csce::test::test_point_cloud() const {
+	bool correct = true;
+	
+	std::cout << "Testing point cloud ... " << std::flush;
+	if(this->debug){
+		std::cout << std::endl;
+	}
+	
+	std::vector<csce::point<double>> points = csce::utility::random_points<double>(5003, -100, 100);
+	
+	{
+		//the arrays are aligned and padded with the last point, which is not part of the cloud
+		csce::point_cloud<double> cloud(points, 8);
+		bool result = (cloud.size() == points.size() && cloud.padded_size() == 5008);
+		result &= (reinterpret_cast<std::uintptr_t>(cloud.x()) % csce::point_cloud<double>::alignment == 0);
+		result &= (reinterpret_cast<std::uintptr_t>(cloud.y()) % csce::point_cloud<double>::alignment == 0);
+		for(std::size_t x=cloud.size(); x<cloud.padded_size(); x++){
+			result &= (cloud.x()[x] == points.back().x && cloud.y()[x] == points.back().y);
+		}
+		result &= (cloud.to_vector() == points);
+		
+		cloud.push_back(csce::point<double>(1, 2));
+		result &= (cloud.size() == points.size() + 1 && cloud.padded_size() == 5008 && cloud.x()[5007] == 1 && cloud.y()[5007] == 2);
+		
+		correct &= result;
+		if(this->debug){
+			std::cout << (result ? "correct" : "INCORRECT") << std::endl;
+		}
+	}
+	
+	{
+		//a view shares the coordinates of the cloud
+		csce::point_cloud<double> cloud(points);
+		csce::point_cloud_view<double> view = cloud.view(100, 200);
+		bool result = (view.size() == 100 && view.x() == cloud.x() + 100 && view.y() == cloud.y() + 100);
+		result &= (view.view(10, 20)[0] == points[110]);
+		result &= (view.to_vector() == std::vector<csce::point<double>>(points.begin() + 100, points.begin() + 200));
+		
+		correct &= result;
+		if(this->debug){
+			std::cout << (result ? "correct" : "INCORRECT") << std::endl;
+		}
+	}
+	
+	{
+		//the pre-filter on the x and y arrays keeps the same points and finds the same hull
+		csce::point_cloud<double> cloud(points);
+		for(int nthreads=1; nthreads<=4; nthreads+=3){
+			csce::akl_toussaint<double, csce::monotone_chain<double>> algorithm(nthreads);
+			std::vector<csce::point<double>> survivors = algorithm.filter(points);
+			std::vector<csce::point<double>> cloud_survivors = algorithm.filter(csce::point_cloud_view<double>(cloud));
+			
+			std::vector<csce::point<double>> points_copy = points;
+			std::vector<csce::point<double>> hull = algorithm.compute_hull(points_copy);
+			std::vector<csce::point<double>> cloud_hull = algorithm.compute_hull(cloud);
+			csce::monotone_chain<double> monotone_chain(nthreads);
+			csce::convex_hull_base<double>& base = monotone_chain; //algorithms without their own overload copy the cloud into a vector
+			std::vector<csce::point<double>> base_hull = base.compute_hull(cloud);
+			
+			bool result = (survivors == cloud_survivors && survivors.size() < points.size() && hull == cloud_hull && hull == base_hull);
+			correct &= result;
+			if(this->debug){
+				std::cout << (result ? "correct" : "INCORRECT") << std::endl;
+			}
+		}
+	}
+	
+	std::cout << (correct ? "correct" : "INCORRECT") << std::endl;
+	return correct;
+}
+
+bool csce::test::test_angular_sort() const {
+	bool correct = true;
+	
+	std::cout << "Testing angular sort ... " << std::flush;
+	if(this->debug){
+		std::cout << std::endl;
+	}
+	
+	{
+		//the radix sort is stable, with one thread and with several (whose buffers come from an arena)
+		csce::scratch_vector<std::uint64_t> keys;
+		csce::scratch_vector<std::uint32_t> values;
+		std::uint64_t state = 12345;
+		for(std::uint32_t x=0; x<200000; x++){
+			state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+			keys.push_back(state & 0xFFFF00FF0000FFFFULL);
+			values.push_back(x);
+		}
+		std::vector<std::pair<std::uint64_t, std::uint32_t>> expected;
+		for(std::size_t x=0; x<keys.size(); x++){
+			expected.push_back(std::make_pair(keys[x], values[x]));
+		}
+		std::stable_sort(expected.begin(), expected.end(), [](const std::pair<std::uint64_t, std::uint32_t>& a, const std::pair<std::uint64_t, std::uint32_t>& b) {
+			return a.first < b.first;
+		});
+		
+		for(int nthreads=1; nthreads<=4; nthreads+=3){
+			csce::scratch_arena arena;
+			csce::scratch_arena::scope scope(arena);
+			csce::scratch_arena* scratch = (nthreads > 1 ? &arena : nullptr);
+			csce::scratch_vector<std::uint64_t> sorted_keys(keys.begin(), keys.end(), csce::arena_allocator<std::uint64_t>(scratch));
+			csce::scratch_vector<std::uint32_t> sorted_values(values.begin(), values.end(), csce::arena_allocator<std::uint32_t>(scratch));
+			csce::radix_sort::sort(sorted_keys, sorted_values, *csce::shared_executor(nthreads));
+			bool result = true;
+			for(std::size_t x=0; x<expected.size(); x++){
+				result &= (sorted_keys[x] == expected[x].first && sorted_values[x] == expected[x].second);
+			}
+			correct &= result;
+			if(this->debug){
+				std::cout << (result ? "correct" : "INCORRECT") << std::endl;
+			}
+		}
+	}
+	
+	{
+		//integer points with many collinear ones and copies of the pivot come out in the same order as std::sort
+		std::vector<csce::point<long long>> points = csce::utility::random_points<long long>(20000, -30, 30);
+		std::size_t pivot = 0;
+		for(std::size_t x=0; x<points.size(); x++){
+			if(points[x].y < points[pivot].y || (points[x].y == points[pivot].y && points[x].x < points[pivot].x)){
+				pivot = x;
+			}
+		}
+		std::swap(points[0], points[pivot]);
+		points.push_back(points[0]);
+		
+		std::vector<csce::point<long long>> expected(points.begin() + 1, points.end());
+		std::sort(expected.begin(), expected.end(), csce::angle_less<long long>(points[0]));
+		
+		for(int nthreads=1; nthreads<=4; nthreads+=3){
+			std::vector<csce::point<long long>> sorted(points.begin() + 1, points.end());
+			csce::angular_sort<long long>(points[0], *csce::shared_executor(nthreads)).sort_array(sorted.begin(), sorted.end());
+			bool result = (sorted == expected && sorted.front() == points[0]);
+			correct &= result;
+			if(this->debug){
+				std::cout << (result ? "correct" : "INCORRECT") << std::endl;
+			}
+		}
+	}
+	
+	{
+		//double points one ulp off of rays from the pivot, whose pseudo-angles round to the same key
+		csce::point<double> pivot(0.5, 0.5);
+		std::vector<csce::point<double>> points;
+		for(int x=1; x<=40; x++){
+			for(int y=-3; y<=3; y++){
+				double scale = 0.1 * x;
+				points.push_back(csce::point<double>(0.5 + scale, std::nextafter(0.5 + scale, y < 0 ? 0.0 : 2.0)));
+				points.push_back(csce::point<double>(0.5 + scale * (y + 4), 0.5 + scale));
+			}
+		}
+		std::vector<csce::point<double>> expected = points;
+		std::sort(expected.begin(), expected.end(), csce::angle_less<double>(pivot));
+		csce::serial_executor serial;
+		csce::angular_sort<double>(pivot, serial).sort_array(points.begin(), points.end());
+		
+		bool result = (points == expected);
+		for(std::size_t x=1; x<points.size(); x++){
+			result &= !csce::angle_less<double>(pivot)(points[x], points[x - 1]);
+		}
+		correct &= result;
+		if(this->debug){
+			std::cout << (result ? "correct" : "INCORRECT") << std::endl;
+		}
+	}
+	
+	std::cout << (correct ? "correct" : "INCORRECT") << std::endl;
+	return correct;
+}
+
+bool csce::test::test_sort_parallel() const {
+	bool correct = true;
+	
+	std::cout << "Testing parallel sort ... " << std::flush;
+	if(this->debug){
+		std::cout << std::endl;
+	}
+	
+	//segment counts that are not powers of two leave a run without a partner in some rounds
+	std::vector<csce::point<long long>> points = csce::utility::random_points<long long>(100003, -200, 200);
+	std::vector<csce::point<long long>> expected = points;
+	std::sort(expected.begin(), expected.end(), csce::monotone_chain<long long>::lexicographic_less);
+	
+	csce::point<long long> pivot(0, -201);
+	std::vector<csce::point<long long>> expected_angles = points;
+	std::sort(expected_angles.begin(), expected_angles.end(), csce::angle_less<long long>(pivot));
+	
+	for(int nthreads=1; nthreads<=7; nthreads+=2){
+		csce::executor& pool = *csce::shared_executor(nthreads);
+		std::vector<csce::point<long long>> sorted = points;
+		csce::monotone_chain_parallel<long long>::sort_array(sorted, pool);
+		bool result = (sorted == expected);
+		
+		std::vector<csce::point<long long>> sorted_angles = points;
+		csce::sort_parallel<long long> sorter(pivot, pool);
+		sorter.sort_array(sorted_angles.begin(), sorted_angles.end());
+		result &= (sorted_angles == expected_angles);
+		
+		correct &= result;
+		if(this->debug){
+			std::cout << nthreads << " threads " << (result ? "correct" : "INCORRECT") << std::endl;
+		}
+	}
+	
+	std::cout << (correct ? "correct" : "INCORRECT") << std::endl;
+	return correct;
+}
+
+bool csce::test::test_executor() const {
+	bool correct = true;
+	
+	std::cout << "Testing executor ... " << std::flush;
+	if(this->debug){
+		std::cout << std::endl;
+	}
+	
+	{
+		//parallel_for visits every index exactly once, in contiguous chunks numbered in order
+		for(int nthreads=1; nthreads<=3; nthreads+=2){
+			csce::executor& pool = *csce::shared_executor(nthreads);
+			std::size_t count = 10007;
+			std::size_t chunks = pool.chunk_count(count, 100);
+			std::vector<int> visits(count, 0);
+			std::vector<std::pair<std::size_t, std::size_t>> ranges(chunks);
+			pool.parallel_for(count, 100, [&](std::size_t chunk, std::size_t begin, std::size_t end) {
+				ranges[chunk] = std::make_pair(begin, end);
+				for(std::size_t x=begin; x<end; x++){
+					visits[x]++;
+				}
+			});
+			
+			bool result = (chunks == static_cast<std::size_t>(nthreads) && ranges.front().first == 0 && ranges.back().second == count);
+			for(std::size_t x=1; x<chunks; x++){
+				result &= (ranges[x].first == ranges[x - 1].second);
+			}
+			for(int visit : visits){
+				result &= (visit == 1);
+			}
+			result &= (pool.chunk_count(count, count) == 1 && pool.chunk_count(0, 100) == 1);
+			correct &= result;
+			if(this->debug){
+				std::cout << (result ? "correct" : "INCORRECT") << std::endl;
+			}
+		}
+	}
+	
+	{
+		//tasks can fork and join their own tasks on the same pool
+		csce::executor& pool = *csce::shared_executor(3);
+		std::atomic<int> leaves(0);
+		pool.fork_join(4, [&](std::size_t) {
+			pool.fork_join(4, [&](std::size_t) {
+				pool.parallel_for(100, 1, [&](std::size_t, std::size_t begin, std::size_t end) {
+					leaves += static_cast<int>(end - begin);
+				});
+			});
+		});
+		
+		bool result = (leaves == 1600);
+		result &= (csce::shared_executor(3) == csce::shared_executor(3) && csce::shared_executor(1)->concurrency() == 1);
+		correct &= result;
+		if(this->debug){
+			std::cout << (result ? "correct" : "INCORRECT") << std::endl;
+		}
+	}
+	
+	{
+		//a task that throws reaches the caller after the other tasks are done, and the pool keeps working
+		bool result = true;
+		for(int nthreads=1; nthreads<=4; nthreads+=3){
+			csce::executor& pool = *csce::shared_executor(nthreads);
+			for(std::size_t thrower=0; thrower<2; thrower++){
+				std::atomic<int> finished(0);
+				std::string caught;
+				try {
+					pool.fork_join(16, [&](std::size_t x) {
+						if(x == thrower * 9){
+							throw "task failed";
+						}
+						pool.parallel_for(1000, 1, [&](std::size_t, std::size_t, std::size_t) {});
+						finished++;
+					});
+				} catch(const char* error) {
+					caught = error;
+				}
+				result &= (caught == "task failed" && finished == 15);
+			}
+			
+			std::atomic<int> leaves(0);
+			pool.parallel_for(100, 1, [&](std::size_t, std::size_t begin, std::size_t end) {
+				leaves += static_cast<int>(end - begin);
+			});
+			result &= (leaves == 100);
+		}
+		correct &= result;
+		if(this->debug){
+			std::cout << (result ? "correct" : "INCORRECT") << std::endl;
+		}
+	}
+	
+	{
+		//parallel quick hull splits its passes over the points into chunks, which find the same extreme and farthest points
+		std::vector<csce::point<double>> points = csce::utility::random_points<double>(400000, -1000000, 1000000);
+		std::vector<csce::point<double>> points_copy = points;
+		std::vector<csce::point<double>> expected = csce::quick_hull<double>(1).compute_hull(points_copy);
+		
+		bool result = true;
+		for(int nthreads=1; nthreads<=4; nthreads+=3){
+			std::vector<csce::point<double>> hull = csce::quick_hull_parallel<double>(nthreads).compute_hull(csce::point_span<double>(points));
+			result &= (hull.size() == expected.size() && std::set<csce::point<double>>(hull.begin(), hull.end()) == std::set<csce::point<double>>(expected.begin(), expected.end()));
+		}
+		correct &= result;
+		if(this->debug){
+			std::cout << (result ? "correct" : "INCORRECT") << std::endl;
+		}
+	}
+	
+	{
+		//an algorithm gives the same hull on a serial executor as on the shared pool
+		std::vector<csce::point<long long>> points = csce::utility::random_points<long long>(50000, -1000, 1000);
+		std::vector<csce::point<long long>> serial_points = points;
+		
+		csce::quick_hull_parallel<long long> algorithm(4);
+		std::vector<csce::point<long long>> hull = algorithm.compute_hull(points);
+		algorithm.set_executor(std::make_shared<csce::serial_executor>());
+		std::vector<csce::point<long long>> serial_hull = algorithm.compute_hull(serial_points);
+		
+		std::vector<std::string> errors;
+		bool result = (hull == serial_hull && csce::utility::validate(hull, points, 1000LL, errors));
+		correct &= result;
+		if(this->debug){
+			std::cout << (result ? "correct" : "INCORRECT") << std::endl;
+		}
+	}
+	
+	std::cout << (correct ? "correct" : "INCORRECT") << std::endl;
+	return correct;
+}
+
+bool csce::test::test_scratch_arena() const {
+	bool correct = true;
+	
+	std::cout << "Testing scratch arena ... " << std::flush;
+	if(this->debug){
+		std::cout << std::endl;
+	}
+	
+	{
+		//allocations are aligned, and a scope gives its memory back to the next one
+		csce::scratch_arena arena;
+		char* first = nullptr;
+		bool result = true;
+		{
+			csce::scratch_arena::scope scope(arena);
+			first = static_cast<char*>(arena.allocate(3, 1));
+			result &= (reinterpret_cast<std::uintptr_t>(arena.allocate(100, 64)) % 64 == 0);
+			{
+				csce::scratch_arena::scope inner(arena);
+				arena.allocate(1000, 8);
+			}
+			result &= (reinterpret_cast<std::uintptr_t>(arena.allocate(8, 8)) % 8 == 0);
+		}
+		{
+			csce::scratch_arena::scope scope(arena);
+			result &= (static_cast<char*>(arena.allocate(3, 1)) == first);
+		}
+		result &= (arena.block_allocations() == 1);
+		correct &= result;
+		if(this->debug){
+			std::cout << (result ? "correct" : "INCORRECT") << std::endl;
+		}
+	}
+	
+	{
+		//a call that outgrows the first block leaves one block big enough for the next call
+		csce::scratch_arena arena(true, true);
+		for(int call=0; call<3; call++){
+			csce::scratch_arena::scope scope(arena);
+			for(int x=0; x<10; x++){
+				std::memset(arena.allocate(1 << 18, 64), x, 1 << 18);
+			}
+		}
+		std::size_t blocks = arena.block_allocations();
+		{
+			csce::scratch_arena::scope scope(arena);
+			for(int x=0; x<10; x++){
+				arena.allocate(1 << 18, 64);
+			}
+		}
+		
+		bool result = (arena.block_allocations() == blocks && arena.capacity() >= 10 << 18 && arena.peak() >= 10 << 18);
+		correct &= result;
+		if(this->debug){
+			std::cout << (result ? "correct" : "INCORRECT") << std::endl;
+		}
+	}
+	
+	{
+		//repeated runs of an algorithm do not allocate scratch memory after the first
+		std::vector<csce::point<double>> points = csce::utility::random_points<double>(100000, -1000, 1000);
+		csce::graham_scan<double> algorithm(1);
+		std::vector<csce::point<double>> points_copy = points;
+		std::vector<csce::point<double>> hull = algorithm.compute_hull(points_copy);
+		std::size_t blocks = algorithm.get_arena()->block_allocations();
+		
+		bool result = (blocks > 0);
+		for(int run=0; run<3; run++){
+			points_copy = points;
+			result &= (algorithm.compute_hull(points_copy) == hull);
+		}
+		result &= (algorithm.get_arena()->block_allocations() == blocks);
+		correct &= result;
+		if(this->debug){
+			std::cout << (result ? "correct" : "INCORRECT") << std::endl;
+		}
+	}
+	
+	{
+		//every point of a circle is on the hull, so quick hull recurses as deep as it can, but its scratch memory stays linear in the input
+		std::vector<csce::point<double>> points;
+		for(int x=0; x<200000; x++){
+			double angle = 2 * M_PI * x / 200000;
+			points.push_back(csce::point<double>(1000000 * std::cos(angle), 1000000 * std::sin(angle)));
+		}
+		std::shuffle(points.begin(), points.end(), std::mt19937(3));
+		csce::quick_hull<double> algorithm(1);
+		std::vector<csce::point<double>> hull = algorithm.compute_hull(points);
+		
+		std::size_t input = points.size() * sizeof(csce::point<double>);
+		bool result = (hull.size() > 190000 && algorithm.get_arena()->peak() <= 4 * input);
+		correct &= result;
+		if(this->debug){
+			std::cout << algorithm.get_arena()->peak() / input << "x the input ... " << (result ? "correct" : "INCORRECT") << std::endl;
+		}
+	}
+	
+	std::cout << (correct ? "correct" : "INCORRECT") << std::endl;
+	return correct;
+}
+
+bool csce::test::test_graham_scan() const {
+	bool correct = true;
+	
+	std::cout << "Testing Graham's scan ... " << std::flush;
+	if(this->debug){
+		std::cout << std::endl;
+	}
+	
+	{
+		//every point is on one line through the pivot, so the scan must not pop the pivot
+		std::vector<csce::point<long long>> points;
+		for(long long x=0; x<50; x++){
+			points.push_back(csce::point<long long>(3 * x - 70, 2 * x - 40));
+			points.push_back(csce::point<long long>(3 * (49 - x) - 70, 2 * (49 - x) - 40));
+		}
+		std::vector<csce::point<long long>> hull = csce::graham_scan<long long>(1).compute_hull(points);
+		
+		std::set<csce::point<long long>> corners(hull.begin(), hull.end());
+		bool result = (hull.size() == 2 && corners.count(csce::point<long long>(-70, -40)) == 1 && corners.count(csce::point<long long>(77, 58)) == 1);
+		correct &= result;
+		if(this->debug){
+			std::cout << (result ? "correct" : "INCORRECT") << std::endl;
+		}
+	}
+	
+	{
+		//on a full grid the pivot is also the west-most point, and many points are collinear with it
+		std::vector<csce::point<long long>> points;
+		for(long long x=-60; x<=60; x++){
+			for(long long y=-60; y<=60; y++){
+				points.push_back(csce::point<long long>(x, y));
+			}
+		}
+		std::mt19937 generator(7);
+		std::shuffle(points.begin(), points.end(), generator);
+		
+		bool result = true;
+		for(int nthreads=1; nthreads<=4; nthreads+=3){
+			std::vector<csce::point<long long>> points_copy = points;
+			std::vector<csce::point<long long>> hull = csce::graham_scan_parallel<long long>(nthreads).compute_hull(points_copy);
+			std::set<csce::point<long long>> corners(hull.begin(), hull.end());
+			result &= (hull.size() == 4 && corners.count(csce::point<long long>(-60, -60)) == 1 && corners.count(csce::point<long long>(60, -60)) == 1);
+			result &= (corners.count(csce::point<long long>(60, 60)) == 1 && corners.count(csce::point<long long>(-60, 60)) == 1);
+		}
+		correct &= result;
+		if(this->debug){
+			std::cout << (result ? "correct" : "INCORRECT") << std::endl;
+		}
+	}
+	
+	{
+		//too many collinear points for the sequential scan, so the parallel scan cleans up its quadrants, and composable hulls combine with it
+		std::vector<csce::point<long long>> points;
+		for(long long x=-1500; x<1500; x++){
+			points.push_back(csce::point<long long>(x, 2 * x + 1));
+		}
+		std::mt19937 generator(11);
+		std::shuffle(points.begin(), points.end(), generator);
+		
+		csce::graham_scan_parallel<long long> parallel(4);
+		csce::composable_hulls<long long, csce::graham_scan<long long>, csce::graham_scan_parallel<long long>> composable_graham(4);
+		csce::composable_hulls<long long, csce::quick_hull<long long>, csce::graham_scan_parallel<long long>> composable_quick(4);
+		std::vector<csce::convex_hull_base<long long>*> algorithms = { &parallel, &composable_graham, &composable_quick };
+		
+		bool result = true;
+		for(auto algorithm : algorithms){
+			std::vector<csce::point<long long>> points_copy = points;
+			std::vector<csce::point<long long>> hull = algorithm->compute_hull(points_copy);
+			std::set<csce::point<long long>> corners(hull.begin(), hull.end());
+			bool found = (hull.size() == 2 && corners.count(csce::point<long long>(-1500, -2999)) == 1 && corners.count(csce::point<long long>(1499, 2999)) == 1);
+			result &= found;
+			if(this->debug && !found){
+				std::cout << algorithm->name() << " returned " << hull.size() << " points" << std::endl;
+			}
+		}
+		
+		//three points on a line, and copies of one point, are too few to scan
+		std::vector<csce::point<long long>> three = { csce::point<long long>(4, 4), csce::point<long long>(0, 0), csce::point<long long>(2, 2) };
+		std::vector<csce::point<long long>> hull = csce::graham_scan<long long>(1).compute_hull(three);
+		result &= (hull.size() == 2 && std::set<csce::point<long long>>(hull.begin(), hull.end()).count(csce::point<long long>(2, 2)) == 0);
+		std::vector<csce::point<long long>> copies = { csce::point<long long>(1, 5), csce::point<long long>(1, 5), csce::point<long long>(1, 5) };
+		result &= (csce::graham_scan<long long>(1).compute_hull(copies).size() == 1);
+		
+		correct &= result;
+		if(this->debug){
+			std::cout << (result ? "correct" : "INCORRECT") << std::endl;
+		}
+	}
+	
+	{
+		//Jarvis' march and quick hull on a grid where every point is repeated, and many share the extreme coordinates
+		std::vector<csce::point<long long>> grid;
+		for(long long x=-20; x<=20; x++){
+			for(long long y=-20; y<=20; y++){
+				grid.push_back(csce::point<long long>(x, y));
+				grid.push_back(csce::point<long long>(x, y));
+			}
+		}
+		//and on a line with repeated points, whose ends are its only corners
+		std::vector<csce::point<long long>> line;
+		for(long long x=0; x<200; x++){
+			line.push_back(csce::point<long long>(2 * x - 150, 90 - x));
+			line.push_back(csce::point<long long>(2 * (x / 2) - 150, 90 - (x / 2)));
+		}
+		std::mt19937 generator(13);
+		std::shuffle(grid.begin(), grid.end(), generator);
+		std::shuffle(line.begin(), line.end(), generator);
+		std::set<csce::point<long long>> grid_corners = { csce::point<long long>(-20, -20), csce::point<long long>(20, -20), csce::point<long long>(20, 20), csce::point<long long>(-20, 20) };
+		std::set<csce::point<long long>> line_corners = { csce::point<long long>(-150, 90), csce::point<long long>(248, -109) };
+		
+		csce::jarvis_march<long long> jarvis(1);
+		csce::jarvis_march_parallel<long long> jarvis_parallel(4);
+		csce::quick_hull<long long> quick(1);
+		csce::quick_hull_parallel<long long> quick_parallel(4);
+		std::vector<csce::convex_hull_base<long long>*> algorithms = { &jarvis, &jarvis_parallel, &quick, &quick_parallel };
+		
+		bool result = true;
+		for(auto algorithm : algorithms){
+			std::vector<csce::point<long long>> points_copy = grid;
+			std::vector<csce::point<long long>> hull = algorithm->compute_hull(points_copy);
+			bool found = (hull.size() == 4 && std::set<csce::point<long long>>(hull.begin(), hull.end()) == grid_corners);
+			points_copy = line;
+			hull = algorithm->compute_hull(points_copy);
+			found &= (hull.size() == 2 && std::set<csce::point<long long>>(hull.begin(), hull.end()) == line_corners);
+			result &= found;
+			if(this->debug && !found){
+				std::cout << algorithm->name() << " returned a point that is not a corner" << std::endl;
+			}
+		}
+		correct &= result;
+		if(this->debug){
+			std::cout << (result ? "correct" : "INCORRECT") << std::endl;
+		}
+	}
+	
+	{
+		//doubles whose y values differ by less than EPS, so only an exact comparison finds the lowest point for the pivot
+		std::mt19937 generator(17);
+		std::uniform_int_distribution<int> coordinate(-8, 8);
+		std::uniform_int_distribution<int> count(4, 12);
+		const double unit = std::ldexp(1.0, -34);
+		
+		csce::graham_scan<double> graham(1);
+		csce::akl_toussaint<double> akl(1);
+		csce::composable_hulls<double, csce::graham_scan<double>, csce::graham_scan_parallel<double>> composable_graham(2);
+		csce::composable_hulls<double, csce::quick_hull<double>, csce::graham_scan_parallel<double>> composable_quick(2);
+		std::vector<csce::convex_hull_base<double>*> algorithms = { &graham, &akl, &composable_graham, &composable_quick };
+		
+		bool result = true;
+		for(int trial=0; trial<500; trial++){
+			std::vector<csce::point<double>> points(count(generator));
+			for(auto& point : points){
+				point = csce::point<double>(coordinate(generator) * unit, coordinate(generator) * unit);
+			}
+			std::vector<csce::point<double>> points_copy = points;
+			std::vector<csce::point<double>> expected = csce::monotone_chain<double>(1).compute_hull(points_copy);
+			std::set<csce::point<double>> corners(expected.begin(), expected.end());
+			for(auto algorithm : algorithms){
+				points_copy = points;
+				std::vector<csce::point<double>> hull = algorithm->compute_hull(points_copy);
+				result &= (hull.size() == corners.size() && std::set<csce::point<double>>(hull.begin(), hull.end()) == corners);
+			}
+		}
+		
+		//and enough of them that the parallel scan finds its extreme points itself
+		std::vector<csce::point<double>> points;
+		for(int x=-30; x<=30; x++){
+			for(int y=-30; y<=30; y++){
+				points.push_back(csce::point<double>(x * unit, y * unit));
+			}
+		}
+		std::shuffle(points.begin(), points.end(), generator);
+		std::set<csce::point<double>> square = { csce::point<double>(-30 * unit, -30 * unit), csce::point<double>(30 * unit, -30 * unit), csce::point<double>(30 * unit, 30 * unit), csce::point<double>(-30 * unit, 30 * unit) };
+		for(int nthreads=1; nthreads<=4; nthreads+=3){
+			std::vector<csce::point<double>> points_copy = points;
+			std::vector<csce::point<double>> hull = csce::graham_scan_parallel<double>(nthreads).compute_hull(points_copy);
+			result &= (hull.size() == 4 && std::set<csce::point<double>>(hull.begin(), hull.end()) == square);
+		}
+		correct &= result;
+		if(this->debug){
+			std::cout << (result ? "correct" : "INCORRECT") << std::endl;
+		}
+	}
+	
+	std::cout << (correct ? "correct" : "INCORRECT") << std::endl;
+	return correct;
+}
+
+bool csce::test::test_point_span() const {
+	bool correct = true;
+	
+	std::cout << "Testing point_span ... " << std::flush;
+	if(this->debug){
+		std::cout << std::endl;
+	}
+	
+	std::vector<csce::point<long long>> points;
+	std::mt19937 generator(11);
+	std::uniform_int_distribution<long long> coordinate(-1000, 1000);
+	for(int x=0; x<20000; x++){
+		points.push_back(csce::point<long long>(coordinate(generator), coordinate(generator)));
+	}
+	
+	{
+		//the span and point_cloud overloads can be called on an algorithm itself, not only through the base class
+		csce::graham_scan<long long> graham(1);
+		csce::monotone_chain<long long> monotone(1);
+		csce::point_cloud<long long> cloud(points);
+		std::vector<csce::point<long long>> points_copy = points;
+		std::vector<csce::point<long long>> hull = graham.compute_hull(points_copy);
+		
+		bool result = (graham.compute_hull(csce::point_span<long long>(points)) == hull && graham.compute_hull(cloud) == hull);
+		std::vector<csce::point<long long>> monotone_hull = monotone.compute_hull(csce::point_span<long long>(points));
+		result &= (monotone.compute_hull(cloud) == monotone_hull && std::set<csce::point<long long>>(monotone_hull.begin(), monotone_hull.end()) == std::set<csce::point<long long>>(hull.begin(), hull.end()));
+		correct &= result;
+		if(this->debug){
+			std::cout << (result ? "correct" : "INCORRECT") << std::endl;
+		}
+	}
+	
+	{
+		//the span is never changed, and gives the same hull as the vector
+		csce::graham_scan<long long> graham(1);
+		csce::quick_hull<long long> quick(1);
+		csce::akl_toussaint<long long> akl(4);
+		csce::jarvis_march<long long> jarvis(1);
+		std::vector<csce::convex_hull_base<long long>*> algorithms = { &graham, &quick, &akl, &jarvis };
+		
+		const std::vector<csce::point<long long>> original = points;
+		bool result = true;
+		for(auto algorithm : algorithms){
+			std::vector<csce::point<long long>> hull = algorithm->compute_hull(csce::point_span<long long>(original.data(), original.size()));
+			result &= (hull == algorithm->compute_hull(csce::point_span<long long>(original)));
+			
+			std::vector<csce::point<long long>> points_copy = points;
+			result &= (hull == algorithm->compute_hull(points_copy));
+		}
+		result &= (original == points);
+		correct &= result;
+		if(this->debug){
+			std::cout << (result ? "correct" : "INCORRECT") << std::endl;
+		}
+	}
+	
+	{
+		//the indices point at the hull's vertices, and a repeated vertex gets the index of its first copy
+		std::vector<csce::point<long long>> repeated = points;
+		repeated.insert(repeated.end(), points.begin(), points.end());
+		csce::quick_hull<long long> quick(1);
+		csce::graham_scan<long long> graham(1);
+		
+		bool result = true;
+		std::vector<csce::point<long long>> hull = quick.compute_hull(csce::point_span<long long>(repeated));
+		std::vector<std::size_t> indices = quick.compute_hull_indices(csce::point_span<long long>(repeated));
+		result &= (indices.size() == hull.size());
+		for(std::size_t x=0; x<indices.size() && result; x++){
+			result &= (indices[x] < points.size() && repeated[indices[x]] == hull[x]);
+		}
+		
+		std::vector<std::size_t> graham_indices = graham.compute_hull_indices(csce::point_span<long long>(repeated));
+		std::set<std::size_t> quick_set(indices.begin(), indices.end());
+		result &= (quick_set == std::set<std::size_t>(graham_indices.begin(), graham_indices.end()));
+		correct &= result;
+		if(this->debug){
+			std::cout << (result ? "correct" : "INCORRECT") << std::endl;
+		}
+	}
+	
+	std::cout << (correct ? "correct" : "INCORRECT") << std::endl;
+	return correct;
+}
+
+bool csce::test::test_point_file() const {
+	bool correct = true;
+	
+	std::cout << "Testing point file ... " << std::flush;
+	if(this->debug){
+		std::cout << std::endl;
+	}
+	
+	char path[] = "/tmp/point_file_test_XXXXXX";
+	int descriptor = mkstemp(path);
+	if(descriptor < 0){
+		std::cout << "INCORRECT (could not create a temporary file)" << std::endl;
+		return false;
+	}
+	close(descriptor);
+	
+	std::shared_ptr<csce::executor> pool = csce::shared_executor(4);
+	std::mt19937 generator(5);
+	std::uniform_int_distribution<long long> coordinate(-1000000, 1000000);
+	std::vector<csce::point<long long>> points;
+	for(int x=0; x<200000; x++){
+		points.push_back(csce::point<long long>(coordinate(generator), coordinate(generator)));
+	}
+	
+	{
+		//interleaved coordinates of the same type are used in place, and can be converted to another type
+		csce::point_file::write(csce::point_span<long long>(points), path, *pool);
+		csce::point_file file(path);
+		csce::point_span<long long> span = file.span<long long>();
+		
+		bool result = (csce::point_file::detect(path) && file.maps<long long>() && !file.maps<double>());
+		result &= (reinterpret_cast<std::uintptr_t>(span.data()) % csce::point_file::alignment == 0);
+		result &= (std::vector<csce::point<long long>>(span.begin(), span.end()) == points && file.span<long long>(10).size() == 10);
+		
+		std::vector<csce::point<double>> converted = file.to_vector<double>(0, *pool);
+		for(std::size_t x=0; x<points.size() && result; x++){
+			result &= (converted[x].x == points[x].x && converted[x].y == points[x].y);
+		}
+		
+		csce::point<long long> lower = points[0], upper = points[0];
+		for(auto& p : points){
+			lower = csce::point<long long>(std::min(lower.x, p.x), std::min(lower.y, p.y));
+			upper = csce::point<long long>(std::max(upper.x, p.x), std::max(upper.y, p.y));
+		}
+		result &= (file.lower<long long>() == lower && file.upper<long long>() == upper);
+		correct &= result;
+		if(this->debug){
+			std::cout << (result ? "correct" : "INCORRECT") << std::endl;
+		}
+	}
+	
+	{
+		//separate coordinates are a point_cloud_view, and a streamed file has the same hull as the points
+		std::vector<csce::point<double>> doubles;
+		for(auto& p : points){
+			doubles.push_back(csce::point<double>(p.x / 8.0, p.y / 8.0));
+		}
+		csce::point_file::write(csce::point_span<double>(doubles), path, *pool, csce::point_file::separate);
+		csce::point_file file(path);
+		csce::point_cloud_view<double> view = file.view<double>();
+		
+		bool result = (!file.maps<double>() && view.size() == doubles.size() && view.to_vector() == doubles);
+		result &= (file.to_vector<double>(0, *pool) == doubles);
+		
+		csce::streaming_hull<double> streaming(1, 5000);
+		std::vector<csce::point<double>> hull = streaming.compute_hull(std::string(path));
+		std::vector<csce::point<double>> expected = csce::quick_hull<double>(1).compute_hull(doubles);
+		result &= (streaming.count() == doubles.size() && std::set<csce::point<double>>(hull.begin(), hull.end()) == std::set<csce::point<double>>(expected.begin(), expected.end()));
+		correct &= result;
+		if(this->debug){
+			std::cout << (result ? "correct" : "INCORRECT") << std::endl;
+		}
+	}
+	
+	{
+		//compressed points come back in Morton order, from whole blocks or from any range of them
+		csce::point_file::write(csce::point_span<long long>(points), path, *pool, csce::point_file::compressed);
+		csce::point_file file(path);
+		std::vector<csce::point<long long>> decoded = file.to_vector<long long>(0, *pool);
+		
+		std::vector<csce::point<long long>> sorted = points;
+		std::vector<csce::point<long long>> decoded_sorted = decoded;
+		std::sort(sorted.begin(), sorted.end());
+		std::sort(decoded_sorted.begin(), decoded_sorted.end());
+		bool result = (file.layout() == csce::point_file::compressed && !file.maps<long long>() && decoded_sorted == sorted);
+		result &= (file.block_count() > 1 && file.block_count() == (points.size() + file.block_size() - 1) / file.block_size());
+		
+		std::vector<csce::point<long long>> part;
+		std::size_t begin = file.block_size() - 7, end = 3 * file.block_size() + 11;
+		file.copy(begin, end, part);
+		result &= (std::vector<csce::point<long long>>(decoded.begin() + begin, decoded.begin() + end) == part && file.get<long long>(12345) == decoded[12345]);
+		
+		csce::streaming_hull<long long> streaming(1, 50000);
+		std::vector<csce::point<long long>> hull = streaming.compute_hull(std::string(path));
+		std::vector<csce::point<long long>> expected = csce::quick_hull<long long>(1).compute_hull(points);
+		result &= (std::set<csce::point<long long>>(hull.begin(), hull.end()) == std::set<csce::point<long long>>(expected.begin(), expected.end()));
+		
+		//a range wider than 32 bits cannot be compressed
+		std::vector<csce::point<long long>> wide = { csce::point<long long>(0, 0), csce::point<long long>(1LL << 40, 1) };
+		try {
+			csce::point_file::write(csce::point_span<long long>(wide), path, *pool, csce::point_file::compressed);
+			result = false;
+		} catch(const char*) {
+		}
+		correct &= result;
+		if(this->debug){
+			std::cout << (result ? "correct" : "INCORRECT") << std::endl;
+		}
+	}
+	
+	{
+		//a text file is not detected, and mapping it is refused
+		csce::utility::write_to_file(csce::point_span<long long>(points.data(), 100), path);
+		bool result = !csce::point_file::detect(path);
+		try {
+			csce::point_file file(path);
+			result = false;
+		} catch(const char*) {
+		}
+		correct &= result;
+		if(this->debug){
+			std::cout << (result ? "correct" : "INCORRECT") << std::endl;
+		}
+	}
+	
+	std::remove(path);
+	std::cout << (correct ? "correct" : "INCORRECT") << std::endl;
+	return correct;
+}
+
+bool csce::test::test_text_loader() const {
+	bool correct = true;
+	
+	std::cout << "Testing text loader ... " << std::flush;
+	if(this->debug){
+		std::cout << std::endl;
+	}
+	
+	{
+		//every number that strtod reads is read the same way, and anything else is refused
+		const char* numbers[] = { "0", "-0", "17", "+17", "-9223372036854775808", "3.25", "-0.000123", "1e5", "2.5E-3", ".5",
+			"123456.78901234567", "12345678901234567890123", "0.1000000000000000055511151231257827", "1e-320", "4.9e-324", "1.7976931348623157e308", "1e400", "inf", "-nan" };
+		bool result = true;
+		for(auto number : numbers){
+			double value = 0;
+			const char* end = number + std::strlen(number);
+			result &= (csce::text_loader::parse(number, end, value) == end);
+			double expected = std::strtod(number, nullptr);
+			result &= (std::memcmp(&value, &expected, sizeof(value)) == 0 || (value != value && expected != expected));
+		}
+		
+		const char* integers[] = { "9223372036854775807", "-9223372036854775808", "1234567890123", "-42" };
+		for(auto number : integers){
+			long long value = 0;
+			const char* end = number + std::strlen(number);
+			result &= (csce::text_loader::parse(number, end, value) == end && value == std::strtoll(number, nullptr, 10));
+		}
+		
+		const char* malformed[] = { "9223372036854775808", "1.5", "12x", "-", "" };
+		for(auto number : malformed){
+			long long value = 0;
+			result &= (csce::text_loader::parse(number, number + std::strlen(number), value) == nullptr);
+		}
+		double value = 0;
+		result &= (csce::text_loader::parse("1.5x", std::strchr("1.5x", '\0'), value) == nullptr && csce::text_loader::parse("1e", std::strchr("1e", '\0'), value) == nullptr);
+		correct &= result;
+		if(this->debug){
+			std::cout << (result ? "correct" : "INCORRECT") << std::endl;
+		}
+	}
+	
+	char path[] = "/tmp/text_loader_test_XXXXXX";
+	int descriptor = mkstemp(path);
+	if(descriptor < 0){
+		std::cout << "INCORRECT (could not create a temporary file)" << std::endl;
+		return false;
+	}
+	close(descriptor);
+	
+	std::shared_ptr<csce::executor> pool = csce::shared_executor(4);
+	std::mt19937 generator(3);
+	std::uniform_real_distribution<double> coordinate(-1e6, 1e6);
+	std::vector<csce::point<double>> points;
+	for(int x=0; x<150000; x++){
+		points.push_back(csce::point<double>(coordinate(generator), coordinate(generator)));
+	}
+	
+	{
+		//a file of several pieces loads the same points as stream extraction, and -n keeps the first ones
+		{
+			std::ofstream file(path);
+			file << std::setprecision(17);
+			for(auto& p : points){
+				file << p.x << " " << p.y << "\n";
+			}
+		}
+		std::size_t total = 0;
+		bool result = (csce::text_loader::load<double>(path, 0, *pool, &total) == points && total == points.size());
+		
+		std::vector<csce::point<double>> first = csce::text_loader::load<double>(path, 1000, *pool, &total);
+		result &= (first.size() == 1000 && total == points.size() && std::equal(first.begin(), first.end(), points.begin()));
+		
+		csce::point_cloud<double> cloud = csce::text_loader::load_cloud<double>(path, 0, *pool, 8);
+		result &= (cloud.to_vector() == points && cloud.padded_size() % 8 == 0 && cloud.x()[cloud.padded_size() - 1] == points.back().x);
+		correct &= result;
+		if(this->debug){
+			std::cout << (result ? "correct" : "INCORRECT") << std::endl;
+		}
+	}
+	
+	{
+		//loading stops at the first line that is not a pair of numbers, like stream extraction
+		std::vector<csce::point<long long>> integers;
+		{
+			std::ofstream file(path);
+			for(long long x=0; x<100000; x++){
+				file << x << " " << -3 * x << "\n";
+				if(x == 77777){
+					file << "12 oops\n";
+				}
+			}
+		}
+		std::vector<csce::point<long long>> expected;
+		{
+			std::ifstream file(path);
+			long long x = 0, y = 0;
+			while(file >> x >> y){
+				expected.push_back(csce::point<long long>(x, y));
+			}
+		}
+		std::size_t total = 0;
+		std::vector<csce::point<long long>> loaded = csce::text_loader::load<long long>(path, 0, *pool, &total);
+		bool result = (loaded == expected && total == 77778);
+		result &= csce::text_loader::load<long long>("/tmp/no/such/file", 0, *pool, &total).empty() && total == 0;
+		correct &= result;
+		if(this->debug){
+			std::cout << (result ? "correct" : "INCORRECT") << std::endl;
+		}
+	}
+	
+	std::remove(path);
+	std::cout << (correct ? "correct" : "INCORRECT") << std::endl;
+	return correct;
+}
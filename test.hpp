@@ -3,11 +3,50 @@
 
 #include <iostream>
 #include <vector>
+#include <cstring>
+#include <cstdint>
+#include <set>
+#include <random>
+#include <fstream>
+#include <sstream>
+#include <iomanip>
+#include <cstdio>
+#include <cstdlib>
+#include <unistd.h>
 
 #include "line.hpp"
 #include "vector2d.hpp"
 #include "point.hpp"
 #include "utility.hpp"
+#include "hull_merge.hpp"
+#include "incremental_hull.hpp"
+#include "dynamic_hull.hpp"
+#include "streaming_hull.hpp"
+#include "sliding_window_hull.hpp"
+#include "approximate_hull.hpp"
+#include "batch_hulls.hpp"
+#include "orientation.hpp"
+#include "robust_predicates.hpp"
+#include "orientation_kernels.hpp"
+#include "point_cloud.hpp"
+#include "akl_toussaint.hpp"
+#include "monotone_chain.hpp"
+#include "angular_sort.hpp"
+#include "radix_sort.hpp"
+#include "sort_parallel.hpp"
+#include "monotone_chain_parallel.hpp"
+#include "executor.hpp"
+#include "scratch_arena.hpp"
+#include "graham_scan.hpp"
+#include "graham_scan_parallel.hpp"
+#include "composable_hulls.hpp"
+#include "quick_hull_parallel.hpp"
+#include "quick_hull.hpp"
+#include "jarvis_march.hpp"
+#include "jarvis_march_parallel.hpp"
+#include "point_span.hpp"
+#include "point_file.hpp"
+#include "text_loader.hpp"
 
 namespace csce {
 	class test {
@@ -21,6 +60,25 @@ namespace csce {
 		bool test_convex_polygon() const;
 		bool test_contains_all_points() const;
 		bool test_validate_convex_hull() const;
+		bool test_hull_merge() const;
+		bool test_incremental_hull() const;
+		bool test_dynamic_hull() const;
+		bool test_streaming_hull() const;
+		bool test_sliding_window_hull() const;
+		bool test_directional_coreset() const;
+		bool test_batch_hulls() const;
+		bool test_exact_orientation() const;
+		bool test_robust_orientation() const;
+		bool test_orientation_kernels() const;
+		bool test_point_cloud() const;
+		bool test_angular_sort() const;
+		bool test_sort_parallel() const;
+		bool test_executor() const;
+		bool test_scratch_arena() const;
+		bool test_graham_scan() const;
+		bool test_point_span() const;
+		bool test_point_file() const;
+		bool test_text_loader() const;
 	};
 }
 
@@ -0,0 +1,279 @@
+#include "text_loader.hpp"
+
+#include <cstring>
+#include <cstdlib>
+#include <algorithm>
+#include <cstdint>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+namespace {
+	const std::size_t minimum_piece = std::size_t(1) << 20;
+	//longer numbers are not written by anything that writes points, so they are not numbers here
+	const std::size_t longest_number = 64;
+
+	//every power of ten that a double holds exactly
+	const double powers_of_ten[] = {
+		1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+		1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+	};
+
+	inline bool is_space(char c) {
+		return c == ' ' || c == '\n' || c == '\t' || c == '\r' || c == '\v' || c == '\f';
+	}
+
+	inline bool is_digit(char c) {
+		return static_cast<unsigned char>(c - '0') < 10;
+	}
+
+	/**
+	 * Whether the 8 bytes at next are all digits, tested at once on a 64-bit word (SWAR): a byte is
+	 * a digit if neither it minus '0' nor it plus 0x46 (which carries past 0x7f above '9') has its
+	 * top bit set.
+	 */
+	inline bool eight_digits(const char* next, std::uint64_t& word) {
+		std::memcpy(&word, next, sizeof(word));
+		return (((word & 0xF0F0F0F0F0F0F0F0ULL) | (((word + 0x0606060606060606ULL) & 0xF0F0F0F0F0F0F0F0ULL) >> 4)) == 0x3333333333333333ULL);
+	}
+
+	/**
+	 * The value of 8 digits from eight_digits, combining neighbouring digits, then pairs, then
+	 * quadruples with one multiplication each. The first digit is in the lowest byte.
+	 */
+	inline std::uint64_t eight_digit_value(std::uint64_t word) {
+		word -= 0x3030303030303030ULL;
+		word = (word * 10) + (word >> 8);
+		word = (((word & 0x000000FF000000FFULL) * 0x000F424000000064ULL) + (((word >> 16) & 0x000000FF000000FFULL) * 0x0000271000000001ULL)) >> 32;
+		return word;
+	}
+
+	inline const char* skip_space(const char* next, const char* end) {
+		while(next < end && is_space(*next)){
+			next++;
+		}
+		return next;
+	}
+
+	/**
+	 * Parses the number at next with strtod, which needs a terminated copy of it.
+	 */
+	const char* parse_slowly(const char* next, const char* end, double& value) {
+		const char* stop = next;
+		while(stop < end && !is_space(*stop)){
+			stop++;
+		}
+		if(stop == next || static_cast<std::size_t>(stop - next) >= longest_number){
+			return nullptr;
+		}
+
+		char number[longest_number];
+		std::memcpy(number, next, stop - next);
+		number[stop - next] = '\0';
+		char* parsed = nullptr;
+		value = std::strtod(number, &parsed);
+		return (parsed == number + (stop - next)) ? stop : nullptr;
+	}
+
+	template<typename T>
+	bool parse_pairs(const char* next, const char* end, std::vector<csce::point<T>>& output) {
+		T x = 0, y = 0;
+		while(true){
+			next = skip_space(next, end);
+			if(next == end){
+				return true;
+			}
+			next = csce::text_loader::parse(next, end, x);
+			if(next == nullptr){
+				return false;
+			}
+			next = skip_space(next, end);
+			if(next == end){
+				return false; //an x without a y
+			}
+			next = csce::text_loader::parse(next, end, y);
+			if(next == nullptr){
+				return false;
+			}
+			output.push_back(csce::point<T>(x, y));
+		}
+	}
+}
+
+csce::text_loader::text_file::text_file(const std::string& path) {
+	int descriptor = open(path.c_str(), O_RDONLY);
+	if(descriptor < 0){
+		return;
+	}
+
+	struct stat status;
+	if(fstat(descriptor, &status) == 0){
+		this->opened = true;
+		this->length = static_cast<std::size_t>(status.st_size);
+	}
+	if(this->length > 0){
+		void* memory = mmap(nullptr, this->length, PROT_READ, MAP_PRIVATE, descriptor, 0);
+		if(memory == MAP_FAILED){
+			this->opened = false;
+			this->length = 0;
+		} else {
+			this->mapping = static_cast<const char*>(memory);
+#ifdef MADV_SEQUENTIAL
+			madvise(memory, this->length, MADV_SEQUENTIAL);
+#endif
+		}
+	}
+	close(descriptor);
+}
+
+csce::text_loader::text_file::~text_file() {
+	if(this->mapping != nullptr){
+		munmap(const_cast<char*>(this->mapping), this->length);
+	}
+}
+
+std::vector<std::size_t> csce::text_loader::text_file::split(std::size_t count) const {
+	count = std::max<std::size_t>(1, std::min(count, this->length / minimum_piece));
+
+	std::vector<std::size_t> starts(1, 0);
+	for(std::size_t x=1; x<count; x++){
+		std::size_t start = std::max(starts.back(), this->length / count * x);
+		const void* newline = std::memchr(this->mapping + start, '\n', this->length - start);
+		if(newline == nullptr){
+			break;
+		}
+		start = static_cast<const char*>(newline) - this->mapping + 1;
+		if(start > starts.back()){
+			starts.push_back(start);
+		}
+	}
+	starts.push_back(this->length);
+	return starts;
+}
+
+const char* csce::text_loader::parse(const char* next, const char* end, long long& value) {
+	bool negative = false;
+	if(next < end && (*next == '-' || *next == '+')){
+		negative = (*next == '-');
+		next++;
+	}
+	if(next == end || !is_digit(*next)){
+		return nullptr;
+	}
+
+	//the magnitude of the most negative value is one more than that of the most positive one
+	const unsigned long long limit = negative ? 9223372036854775808ULL : 9223372036854775807ULL;
+	unsigned long long magnitude = 0;
+	std::uint64_t word = 0;
+	while(end - next >= 8 && magnitude < 10000000000ULL && eight_digits(next, word)){
+		magnitude = magnitude * 100000000ULL + eight_digit_value(word); //below 10^18, so it cannot overflow
+		next += 8;
+	}
+	for(; next < end && is_digit(*next); next++){
+		unsigned long long digit = static_cast<unsigned long long>(*next - '0');
+		if(magnitude > (limit - digit) / 10){
+			return nullptr;
+		}
+		magnitude = magnitude * 10 + digit;
+	}
+	if(next < end && !is_space(*next)){
+		return nullptr;
+	}
+
+	value = negative ? static_cast<long long>(0 - magnitude) : static_cast<long long>(magnitude);
+	return next;
+}
+
+const char* csce::text_loader::parse(const char* next, const char* end, double& value) {
+	const char* start = next;
+	bool negative = false;
+	if(next < end && (*next == '-' || *next == '+')){
+		negative = (*next == '-');
+		next++;
+	}
+
+	//up to 19 significant digits fit in the mantissa; the decimal point moves the exponent
+	unsigned long long mantissa = 0;
+	int significant = 0;
+	int exponent = 0;
+	bool digits = false;
+	bool truncated = false;
+	std::uint64_t word = 0;
+	while(end - next >= 8 && significant <= 11 && eight_digits(next, word)){
+		digits = true;
+		mantissa = mantissa * 100000000ULL + eight_digit_value(word);
+		significant = (mantissa != 0) ? significant + 8 : 0; //leading zeros may count, which only sends more numbers to strtod
+		next += 8;
+	}
+	for(; next < end && is_digit(*next); next++){
+		digits = true;
+		if(significant < 19){
+			mantissa = mantissa * 10 + static_cast<unsigned long long>(*next - '0');
+			significant += (mantissa != 0);
+		} else {
+			exponent++;
+			truncated = true;
+		}
+	}
+	if(next < end && *next == '.'){
+		next++;
+		while(end - next >= 8 && significant <= 11 && eight_digits(next, word)){
+			digits = true;
+			mantissa = mantissa * 100000000ULL + eight_digit_value(word);
+			significant = (mantissa != 0) ? significant + 8 : 0;
+			exponent -= 8;
+			next += 8;
+		}
+		for(; next < end && is_digit(*next); next++){
+			digits = true;
+			if(significant < 19){
+				mantissa = mantissa * 10 + static_cast<unsigned long long>(*next - '0');
+				significant += (mantissa != 0);
+				exponent--;
+			} else {
+				truncated = true;
+			}
+		}
+	}
+	if(!digits){
+		return parse_slowly(start, end, value);
+	}
+
+	if(next < end && (*next == 'e' || *next == 'E')){
+		next++;
+		bool negative_exponent = false;
+		if(next < end && (*next == '-' || *next == '+')){
+			negative_exponent = (*next == '-');
+			next++;
+		}
+		if(next == end || !is_digit(*next)){
+			return nullptr;
+		}
+		int written = 0;
+		for(; next < end && is_digit(*next); next++){
+			written = std::min(written * 10 + (*next - '0'), 100000);
+		}
+		exponent += negative_exponent ? -written : written;
+	}
+	if(next < end && !is_space(*next)){
+		return parse_slowly(start, end, value);
+	}
+
+	//a mantissa below 2^53 and a power of ten up to 10^22 are both exact, so one operation rounds correctly
+	if(!truncated && mantissa <= (1ULL << 53) && exponent >= -22 && exponent <= 22){
+		double magnitude = static_cast<double>(mantissa);
+		magnitude = (exponent < 0) ? magnitude / powers_of_ten[-exponent] : magnitude * powers_of_ten[exponent];
+		value = negative ? -magnitude : magnitude;
+		return next;
+	}
+	return parse_slowly(start, end, value);
+}
+
+bool csce::text_loader::parse_points(const char* begin, const char* end, std::vector<csce::point<long long>>& output) {
+	return parse_pairs(begin, end, output);
+}
+
+bool csce::text_loader::parse_points(const char* begin, const char* end, std::vector<csce::point<double>>& output) {
+	return parse_pairs(begin, end, output);
+}
@@ -0,0 +1,168 @@
+#ifndef text_loader_hpp
+#define text_loader_hpp
+
+#include <vector>
+#include <string>
+#include <cstdint>
+#include <type_traits>
+
+#include "point.hpp"
+#include "point_cloud.hpp"
+#include "executor.hpp"
+
+namespace csce {
+	namespace text_loader {
+		//more pieces than threads, so that a thread that finishes early can take another
+		const std::size_t pieces_per_thread = 4;
+
+
+		/**
+		 * A text file mapped into memory, which is empty if the file cannot be opened.
+		 */
+		class text_file {
+		public:
+			explicit text_file(const std::string& path);
+			~text_file();
+
+			const char* data() const {
+				return this->mapping;
+			}
+
+			std::size_t size() const {
+				return this->length;
+			}
+
+			bool is_open() const {
+				return this->opened;
+			}
+
+			/**
+			 * Splits the file into up to count pieces of about the same size (but no smaller than a
+			 * megabyte) that each end right after a newline or at the end of the file, and returns
+			 * where each piece starts, followed by the size of the file.
+			 */
+			std::vector<std::size_t> split(std::size_t count) const;
+
+		private:
+			text_file(const text_file&);
+			text_file& operator=(const text_file&);
+
+			const char* mapping = nullptr;
+			std::size_t length = 0;
+			bool opened = false;
+		};
+
+
+		/**
+		 * Parses the number that starts at next, and returns where it ends, or nullptr if the text
+		 * there is not a number followed by whitespace or the end. Integers must fit in 64 bits.
+		 * Decimals with at most 19 significant digits and a small exponent are converted exactly
+		 * with one multiplication or division by a power of ten; the rest, and spellings such as
+		 * "inf", go through strtod, so every value is rounded correctly.
+		 */
+		const char* parse(const char* next, const char* end, long long& value);
+		const char* parse(const char* next, const char* end, double& value);
+
+
+		/**
+		 * Appends the "x y" pairs in [begin, end) to output. Returns true if the range was used up,
+		 * or false if it stopped at something that is not a pair of numbers.
+		 */
+		bool parse_points(const char* begin, const char* end, std::vector<csce::point<long long>>& output);
+		bool parse_points(const char* begin, const char* end, std::vector<csce::point<double>>& output);
+
+
+		/**
+		 * Parses the pieces of the file at the same time, one task per piece, into parsed, and sets
+		 * offsets[x] to where piece x starts among all of the points. Returns the number of pieces
+		 * that are used: the pieces after the first one that stopped early are left out, like the
+		 * rest of a stream after a bad number.
+		 */
+		template<typename V>
+		std::size_t parse_file(const std::string& path, csce::executor& pool, std::vector<std::vector<csce::point<V>>>& parsed, std::vector<std::size_t>& offsets) {
+			csce::text_loader::text_file file(path);
+			std::vector<std::size_t> starts = file.split(static_cast<std::size_t>(pool.concurrency()) * pieces_per_thread);
+			std::size_t pieces = starts.size() - 1;
+
+			parsed.assign(pieces, std::vector<csce::point<V>>());
+			std::vector<char> complete(pieces, 0);
+			pool.fork_join(pieces, [&](std::size_t x) {
+				parsed[x].reserve((starts[x + 1] - starts[x]) / 16);
+				complete[x] = csce::text_loader::parse_points(file.data() + starts[x], file.data() + starts[x + 1], parsed[x]);
+			});
+
+			offsets.assign(pieces + 1, 0);
+			std::size_t used = 0;
+			while(used < pieces){
+				offsets[used + 1] = offsets[used] + parsed[used].size();
+				used++;
+				if(!complete[used - 1]){
+					break;
+				}
+			}
+			return used;
+		}
+
+
+		/**
+		 * Loads the whitespace separated "x y" pairs of a text file, one pair per line, like
+		 * utility::write_to_file writes them. The file is mapped and split at newlines into a few
+		 * pieces per thread of pool, which are parsed at the same time and then copied into place
+		 * at the same time.
+		 *
+		 * Like stream extraction, loading stops at the first text that is not a number. Only the
+		 * first limit points are kept (all of them if limit is 0), but total is set to the number
+		 * of points in the file either way, so that a caller can tell when some were left out.
+		 */
+		template<typename T>
+		std::vector<csce::point<T>> load(const std::string& path, std::size_t limit, csce::executor& pool, std::size_t* total = nullptr) {
+			std::vector<std::vector<csce::point<typename std::conditional<std::is_integral<T>::value, long long, double>::type>>> parsed;
+			std::vector<std::size_t> offsets;
+			std::size_t used = csce::text_loader::parse_file(path, pool, parsed, offsets);
+			if(total != nullptr){
+				*total = offsets[used];
+			}
+
+			std::size_t n = (limit == 0) ? offsets[used] : std::min(limit, offsets[used]);
+			std::vector<csce::point<T>> points(n);
+			pool.fork_join(used, [&](std::size_t x) {
+				for(std::size_t y=0; y<parsed[x].size() && offsets[x] + y < n; y++){
+					points[offsets[x] + y] = csce::point<T>(static_cast<T>(parsed[x][y].x), static_cast<T>(parsed[x][y].y));
+				}
+			});
+			return points;
+		}
+
+
+		/**
+		 * Loads the same points into separate x and y arrays.
+		 */
+		template<typename T>
+		csce::point_cloud<T> load_cloud(const std::string& path, std::size_t limit, csce::executor& pool, std::size_t padding = 1, std::size_t* total = nullptr) {
+			std::vector<std::vector<csce::point<typename std::conditional<std::is_integral<T>::value, long long, double>::type>>> parsed;
+			std::vector<std::size_t> offsets;
+			std::size_t used = csce::text_loader::parse_file(path, pool, parsed, offsets);
+			if(total != nullptr){
+				*total = offsets[used];
+			}
+
+			std::size_t n = (limit == 0) ? offsets[used] : std::min(limit, offsets[used]);
+			csce::point_cloud<T> cloud(padding);
+			cloud.resize(n);
+			T* xs = cloud.x();
+			T* ys = cloud.y();
+			pool.fork_join(used, [&](std::size_t x) {
+				for(std::size_t y=0; y<parsed[x].size() && offsets[x] + y < n; y++){
+					xs[offsets[x] + y] = static_cast<T>(parsed[x][y].x);
+					ys[offsets[x] + y] = static_cast<T>(parsed[x][y].y);
+				}
+			});
+			if(n > 0){
+				cloud.set(n - 1, cloud[n - 1]); //fills the padding with the last point
+			}
+			return cloud;
+		}
+	}
+}
+
+#endif /* text_loader_hpp */
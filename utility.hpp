@@ -10,10 +10,16 @@
 #include <unordered_set>
 #include <thread>
 #include <algorithm>
+#include <cstdint>
+#include <memory>
 
 #include "point.hpp"
+#include "point_span.hpp"
 #include "vector2d.hpp"
 #include "line.hpp"
+#include "orientation_kernels.hpp"
+#include "executor.hpp"
+#include "text_loader.hpp"
 
 namespace csce {
 	namespace utility {
@@ -60,33 +66,27 @@ namespace csce {
 		}
 		
 		
+		/**
+		 * Reads up to n points from the file, or all of them if n is not positive, with the
+		 * parallel text_loader.
+		 */
 		template<typename T>
 		std::vector<csce::point<T>> points_from_file(int n, const std::string& file_path) {
-			std::vector<csce::point<T>> points;
-			points.reserve(n);
-			
-			std::ifstream file(file_path, std::ios::in);
-			if(file.is_open()){
-				T x=0, y=0;
-				while(file >> x >> y){
-					points.push_back(csce::point<T>(x, y));
-					if(points.size() >= n){
-						break;
-					}
-				}
-				file.close();
-			}
-			
-			return points;
+			std::shared_ptr<csce::executor> pool = csce::shared_executor(std::thread::hardware_concurrency());
+			return csce::text_loader::load<T>(file_path, n > 0 ? static_cast<std::size_t>(n) : 0, *pool);
 		}
 		
 		
+		/**
+		 * Writes the points as text, one "x y" line per point. The stream is flushed once at the end
+		 * instead of after every line.
+		 */
 		template<typename T>
-		void write_to_file(const std::vector<csce::point<T>>& points, const std::string& file_path) {
+		void write_to_file(const csce::point_span<T>& points, const std::string& file_path) {
 			std::ofstream file(file_path, std::ios_base::out | std::ios_base::trunc);
 			if(file.is_open()){
 				for(auto& point : points){
-					file << point.x << " " << point.y << std::endl;
+					file << point.x << ' ' << point.y << '\n';
 				}
 				file.close();
 			}
@@ -178,8 +178,8 @@ namespace csce {
 			
 		}
 		
-		template<typename T>
-		bool contains_all_points(const std::vector<csce::point<T>>& convex_hull, const std::vector<csce::point<T>>& points, T max, std::vector<std::string>& output_errors) {
+		template<typename T, typename Points = std::vector<csce::point<T>>>
+		bool contains_all_points(const std::vector<csce::point<T>>& convex_hull, const Points& points, T max, std::vector<std::string>& output_errors) {
 			unsigned int thread_count = std::max(static_cast<unsigned int>(4), std::thread::hardware_concurrency());
 			
 			std::unordered_set<csce::point<T>> point_set;
@@ -197,34 +197,52 @@ namespace csce {
 				point_vector.push_back(point);
 			}
 			
-			std::thread* threads = new std::thread[thread_count];
-			int nelements = static_cast<int>(std::ceil(static_cast<double>(point_vector.size()) / static_cast<double>(thread_count)));
-			int start = 0, stop = nelements;
-			int segment_count = 0;
+			std::shared_ptr<csce::executor> pool = csce::shared_executor(thread_count);
+			std::vector<std::vector<std::string>> thread_errors(pool->chunk_count(point_vector.size(), 1));
+			pool->parallel_for(point_vector.size(), 1, [&](std::size_t chunk, std::size_t begin, std::size_t end) {
+				csce::utility::contains_all_points_thread<T>(convex_hull, point_vector.begin() + begin, point_vector.begin() + end, max, thread_errors[chunk]);
+			});
 			
-			std::vector<std::vector<std::string>> thread_errors;
-			thread_errors.resize(thread_count);
+			for(auto& errors : thread_errors){
+				for(auto& error : errors){
+					output_errors.push_back(error);
+				}
+			}
 			
-			for(int x=0; x<thread_count && start < point_vector.size(); x++, start += nelements, stop += nelements){
-				threads[x] = std::thread(csce::utility::contains_all_points_thread<T>, convex_hull, point_vector.begin() + start, std::min(point_vector.begin() + stop, point_vector.end()), max, std::ref(thread_errors[x]));
-				segment_count++;
+			return output_errors.size() == 0;
+		}
+		
+		
+		/**
+		 * A faster check for a closed convex polygon whose vertices turn in the given direction (+1 for
+		 * counterclockwise, -1 for clockwise): a point is inside if it is not strictly outside of any edge,
+		 * so every edge is tested against all of the points at once.
+		 */
+		template<typename T, typename Points = std::vector<csce::point<T>>>
+		bool contains_all_points_convex(const std::vector<csce::point<T>>& convex_hull, const Points& points, int direction, std::vector<std::string>& output_errors) {
+			//the outside of an edge is to its right in a counterclockwise polygon, and to its left in a clockwise one
+			std::vector<std::uint64_t> outside((points.size() + 63) / 64);
+			for(std::size_t x=0; x<convex_hull.size() - 1; x++){
+				csce::orientation_kernels::mark(points.data(), points.size(), convex_hull[x], convex_hull[x+1], -direction, outside.data());
 			}
 			
-			for(int x=0; x<segment_count; x++){
-				threads[x].join();
-				for(auto& error : thread_errors[x]){
-					output_errors.push_back(error);
+			for(std::size_t x=0; x<points.size(); x++){
+				if((outside[x / 64] >> (x % 64)) & 1){
+					std::stringstream error;
+					error << "Point " << points[x].str() << " is not inside the convex hull.";
+					output_errors.push_back(error.str());
 				}
 			}
 			
-			delete[] threads;
-			
 			return output_errors.size() == 0;
 		}
 		
 		
-		template<typename T>
-		bool validate(const std::vector<csce::point<T>>& convex_hull, const std::vector<csce::point<T>>& points, T max, std::vector<std::string>& output_errors) {
+		/**
+		 * Checks that the hull is convex and contains every point. Points is a vector of points or a point_span.
+		 */
+		template<typename T, typename Points = std::vector<csce::point<T>>>
+		bool validate(const std::vector<csce::point<T>>& convex_hull, const Points& points, T max, std::vector<std::string>& output_errors) {
 			if(convex_hull.empty()){
 				return points.empty();
 			}
@@ -246,7 +264,17 @@ namespace csce {
 				return false;
 			}
 			
-			if(!csce::utility::contains_all_points(polygon, points, max, output_errors)){
+			//a polygon whose turns are all collinear has no inside, so it is left to the ray casting
+			int direction = 0;
+			for(std::size_t x=0; x+2<polygon.size() && direction == 0; x++){
+				direction = csce::orientation::turn(polygon[x], polygon[x+1], polygon[x+2]);
+			}
+			
+			if(direction != 0){
+				if(!csce::utility::contains_all_points_convex(polygon, points, direction, output_errors)){
+					return false;
+				}
+			} else if(!csce::utility::contains_all_points(polygon, points, max, output_errors)){
 				return false;
 			}
 			
@@ -7,6 +7,7 @@
 
 #include "point.hpp"
 #include "math_utility.hpp"
+#include "orientation.hpp"
 
 namespace csce {
 	template<typename T>
@@ -14,16 +15,21 @@ namespace csce {
 	public:
 		csce::point<T> p;
 		
-		vector2d(csce::point<T> p1, csce::point<T> p2) {
+		vector2d(csce::point<T> p1, csce::point<T> p2) : origin(p1), tip(p2) {
 			this->p = p2 - p1;
 		}
 		
-		T dot(const csce::vector2d<T>& other) const {
-			return this->p.x * other.p.x + this->p.y * other.p.y;
+		/**
+		 * Integer coordinates are widened before multiplying (see orientation::wide), so the products do not overflow.
+		 */
+		typename csce::orientation::wide<T>::type dot(const csce::vector2d<T>& other) const {
+			typedef typename csce::orientation::wide<T>::type W;
+			return static_cast<W>(this->p.x) * other.p.x + static_cast<W>(this->p.y) * other.p.y;
 		}
 		
-		T cross(const csce::vector2d<T>& other) const {
-			return this->p.x * other.p.y - this->p.y * other.p.x;
+		typename csce::orientation::wide<T>::type cross(const csce::vector2d<T>& other) const {
+			typedef typename csce::orientation::wide<T>::type W;
+			return static_cast<W>(this->p.x) * other.p.y - static_cast<W>(this->p.y) * other.p.x;
 		}
 		
 		bool ccw(const csce::vector2d<T>& other) const {
@@ -42,13 +48,16 @@ namespace csce {
 		 * Returns 0 if the other vector is collinear with this vector,
 		 * +1 if the other vector is counterclockwise to this vector,
 		 * -1 if the other vector is clockwise to this vector.
+		 * Vectors from the same point are compared by the turn of their end points, and others by the
+		 * turn of p and other.p from (0, 0), since p has already been rounded. The sign of either turn is
+		 * exact for integer coordinates, and for double ones, whose turns go through
+		 * robust_predicates::orient2d (see orientation::cross); float and long double turns use EPS.
 		 */
 		int orientation(const csce::vector2d<T>& other) const {
-			T cross_product = this->cross(other);
-			if(csce::math_utility::equals_zero(cross_product))
-				return 0;
-			
-			return (cross_product < 0) ? -1 : 1;
+			if(this->origin == other.origin){
+				return csce::orientation::turn(this->origin, this->tip, other.tip);
+			}
+			return csce::orientation::turn(csce::point<T>(), this->p, other.p);
 		}
 		
 		std::string str() const {
@@ -63,7 +72,8 @@ namespace csce {
 		}
 		
 	private:
-		
+		csce::point<T> origin;
+		csce::point<T> tip;
 	};
 }
 